@@ -21,6 +21,13 @@ else()
     "ADMission doesn't use OpenMP! This configuration is only for debug purposes.")
 endif()
 
+# Face DAG container
+if(ADM_FLAT_FACE_DAG)
+  nag_print_status("ADMission face DAG container: flat")
+else()
+  nag_print_status("ADMission face DAG container: boost::adjacency_list")
+endif()
+
 # Libs
 if(ADM_STATIC_LIBS AND ADM_SHARED_LIBS)
   nag_print_status("ADMission libraries: static and shared")
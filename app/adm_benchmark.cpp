@@ -0,0 +1,175 @@
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "graph/face_dag.hpp"
+#include "graph/read_graph.hpp"
+#include "lower_bounds/lower_bound.hpp"
+#include "lower_bounds/simple_min_acc_cost_bound.hpp"
+#include "operations/op_sequence.hpp"
+#include "optimizers/all_optimizers.hpp"
+#include "optimizers/optimizer.hpp"
+#include "factory.hpp"
+
+#include <boost/foreach.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <stddef.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+/// Minimal runtime of a single measurement in seconds.
+static constexpr double min_time = 0.2;
+
+/**Repeats f until min_time has passed and returns the
+ * mean runtime of a single call in microseconds.
+ */
+template<typename F>
+double time_us(F&& f)
+{
+  size_t reps = 0;
+  double t = omp_get_wtime();
+  double elapsed = 0;
+  do
+  {
+    f();
+    ++reps;
+    elapsed = omp_get_wtime() - t;
+  } while (elapsed < min_time);
+  return elapsed * 1e6 / reps;
+}
+
+/**Sums up the edge indices seen by a traversal of all vertices and
+ * their in- and out-edges, as done by the optimizers.
+ */
+template<typename Graph>
+admission::flop_t traverse(const Graph& g)
+{
+  admission::flop_t sum = 0;
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    BOOST_FOREACH(auto e, out_edges(v, g))
+    {
+      sum += admission::index(e, g) * target(e, g);
+    }
+    BOOST_FOREACH(auto e, in_edges(v, g))
+    {
+      sum += admission::index(e, g) * source(e, g);
+    }
+  }
+  return sum;
+}
+
+/**Measures copying and traversing a face DAG of type Graph.
+ */
+template<typename Graph>
+void bench_container(const char* name, const admission::FaceDAG& g_f)
+{
+  Graph g;
+  admission::convert_face_dag(g_f, g);
+
+  volatile size_t sink = 0;
+  double t_copy = time_us(
+      [&]()
+      {
+        Graph h(g);
+        sink = sink + num_edges(h);
+      });
+  double t_trav = time_us([&]() { sink = sink + traverse(g); });
+
+  std::cout << "  " << std::left << std::setw(14) << name << std::right
+            << " copy " << std::setw(10) << std::fixed << std::setprecision(2)
+            << t_copy << "us  traverse " << std::setw(10) << t_trav << "us\n";
+}
+
+/**Measures evaluating all registered lower bounds on a face DAG.
+ */
+void bench_lower_bounds(const admission::FaceDAG& g)
+{
+  volatile admission::flop_t sink = 0;
+  for (const auto& name :
+       admission::LowerBoundFactory::instance()->known_types())
+  {
+    admission::LowerBound* lb =
+        admission::LowerBoundFactory::instance()->construct(name);
+    double t = time_us([&]() { sink = sink + (*lb)(g); });
+    std::cout << "  " << std::left << std::setw(22) << name << std::right
+              << " bound " << std::setw(12) << (*lb)(g) << "fma "
+              << std::setw(10) << std::fixed << std::setprecision(2) << t
+              << "us\n";
+    delete lb;
+  }
+}
+
+/**Benchmarks the BoostFaceDAG and the FlatFaceDAG containers on
+ * the face DAGs of the given DAGs and solves them with an optimizer
+ * on the configured FaceDAG, after timing the lower bounds on it.
+ *
+ * Usage: adm_benchmark <optimizer_name> <graph> [<graph> ...]
+ */
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cout << "Usage: " << argv[0]
+              << " <optimizer_name> <graph> [<graph> ...]" << std::endl;
+    return -1;
+  }
+
+#ifdef ADM_FLAT_FACE_DAG
+  std::cout << "FaceDAG container: FlatFaceDAG\n";
+#else
+  std::cout << "FaceDAG container: BoostFaceDAG\n";
+#endif
+  omp_set_num_threads(1);
+
+  for (int a = 2; a < argc; ++a)
+  {
+    admission::DAG g;
+    try
+    {
+      admission::read_graph(argv[a], g);
+    }
+    catch (std::runtime_error& e)
+    {
+      std::cout << e.what() << std::endl;
+      return -1;
+    }
+    auto g_f = admission::make_face_dag(g);
+
+    std::cout << argv[a] << ": |V|=" << num_vertices(*g_f)
+              << " |E|=" << num_edges(*g_f) << "\n";
+    bench_container<admission::BoostFaceDAG>("BoostFaceDAG", *g_f);
+    bench_container<admission::FlatFaceDAG>("FlatFaceDAG", *g_f);
+    bench_lower_bounds(*g_f);
+
+    admission::Optimizer* op;
+    try
+    {
+      op = admission::OptimizerFactory::instance()->construct(argv[1]);
+    }
+    catch (admission::KeyNotRegisteredError& knre)
+    {
+      std::cout << knre.what() << std::endl;
+      return -1;
+    }
+    admission::SimpleMinAccCostBound lb;
+    if (op->has_lower_bound())
+    {
+      op->set_lower_bound(lb);
+    }
+
+    double t = omp_get_wtime();
+    auto seq = op->solve(*g_f);
+    t = omp_get_wtime() - t;
+    std::cout << "  " << argv[1] << " " << seq.cost() << "fma in "
+              << t * 1e3 << "ms\n";
+    delete op;
+  }
+  return 0;
+}
@@ -185,7 +185,7 @@ int main(int argc, char* argv[])
   // Use an accumulator to apply the seq, accum. the trivial way and compare.
   auto time = omp_get_wtime();
   std::cout << "Accumulating according to OpSequence... " << std::endl;
-  s.apply(*g_f);
+  s.indexed_apply(*g_f);
   std::cout << "...done." << std::endl;
   std::cout << "Accumulating trivially... " << std::endl;
   auto acc_g_f = admission::accumulate_trivial(g);
@@ -7,23 +7,29 @@
 #include "graph/read_graph.hpp"
 #include "graph/tikz.hpp"
 #include "lower_bounds/lower_bound.hpp"
+#include "lower_bounds/lower_bound_portfolio.hpp"
+#include "lower_bounds/min_mul_cost_bound.hpp"
 #include "lower_bounds/simple_min_acc_cost_bound.hpp"
 #include "operations/op_sequence.hpp"
 #include "optimizers/all_optimizers.hpp"
+#include "optimizers/decomposition.hpp"
 #include "optimizers/optimizer.hpp"
 #include "elimination_algorithm.hpp"
 #include "factory.hpp"
 #include "global_modes.hpp"
 #include "properties.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <omp.h>
 #include <stddef.h>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // **************************** Source contents ***************************** //
 
@@ -38,6 +44,8 @@ class SolveProperties : public admission::Properties
 
   fs::path graph_path = "";
   std::string optimizer_name = "";
+  std::string lower_bound_name = "SimpleMinAccCostBound";
+  std::string lower_bound_portfolio = "SimpleMinAccCostBound";
   size_t n_threads = 1;
   size_t n_levels = 1;
   bool diagnostics = false;
@@ -45,6 +53,25 @@ class SolveProperties : public admission::Properties
   bool preaccumulate_all = false;
   double solution_output_interval = 1.0;
   bool human_readable = true;
+  fs::path progress_json_path = "";
+  size_t tt_size = 0;
+  std::string tt_policy = "depth";
+  std::string bnb_mode = "tasks";
+  size_t best_first_memory = 1024;
+  bool partial_order_reduction = false;
+  std::string heuristic_policy = "always";
+  size_t heuristic_depth = 4;
+  double heuristic_min_subtree = 1e6;
+  size_t heuristic_window = 64;
+  bool heuristic_reuse = false;
+  size_t search_space_probes = 16;
+  size_t search_space_probe_budget = 1000;
+  fs::path checkpoint_path = "";
+  double checkpoint_interval = 600;
+  size_t checkpoint_depth = 3;
+  fs::path resume_from = "";
+  fs::path initial_solution = "";
+  bool decompose = false;
 
   SolveProperties()
   {
@@ -77,6 +104,94 @@ class SolveProperties : public admission::Properties
     register_property(
         human_readable, "human_readable_output",
         "Print solution update as a single line or in log style.");
+    register_property(
+        progress_json_path, "progress_json_path",
+        "File to also write the progress updates to as JSON lines. "
+        "Default is none.");
+    register_property(
+        tt_size, "transposition_table_size",
+        "Memory of the branch and bound transposition table in MB. "
+        "Default is 0 (disabled).");
+    register_property(
+        tt_policy, "transposition_table_policy",
+        "Replacement policy of the transposition table (depth or always). "
+        "Default is depth.");
+    register_property(
+        bnb_mode, "bnb_execution_mode",
+        "How the branch and bound distributes the search tree to threads "
+        "(tasks or work_stealing). Default is tasks.");
+    register_property(
+        best_first_memory, "best_first_memory",
+        "Memory of the open list of the BestFirstOptimizer in MB before it "
+        "falls back to depth-first search. Default is 1024.");
+    register_property(
+        partial_order_reduction, "partial_order_reduction",
+        "Search every order of independent operations only once in the "
+        "branch and bound and report the skipped branches. Ignored if the "
+        "transposition table is enabled. Default is 0.");
+    register_property(
+        heuristic_policy, "heuristic_policy",
+        "At which nodes the branch and bound runs the greedy heuristics "
+        "(always, depth, estimate or adaptive). Default is always.");
+    register_property(
+        heuristic_depth, "heuristic_depth",
+        "Deepest node the heuristics run at with heuristic_policy depth. "
+        "Default is 4.");
+    register_property(
+        heuristic_min_subtree, "heuristic_min_subtree",
+        "Smallest estimated subtree the heuristics run on with "
+        "heuristic_policy estimate. Default is 1000000.");
+    register_property(
+        heuristic_window, "heuristic_window",
+        "Runs without improving the global optimum after which "
+        "heuristic_policy adaptive halves the frequency of the heuristics. "
+        "Default is 64.");
+    register_property(
+        heuristic_reuse, "heuristic_reuse",
+        "Reuse the rest of the heuristic solution of a node at its child "
+        "if it starts with the branch to the child. Default is 0.");
+    register_property(
+        search_space_probes, "search_space_probes",
+        "Random probes estimating the size of the branch and bound search "
+        "tree for the progress output, 0 uses the mean branching per depth "
+        "instead. Default is 16.");
+    register_property(
+        search_space_probe_budget, "search_space_probe_budget",
+        "Lower bound evaluations a search space probe may spend, 0 for no "
+        "limit. Default is 1000.");
+    register_property(
+        checkpoint_path, "checkpoint_path",
+        "File the branch and bound periodically writes its completed "
+        "subtrees and current optimum to. Default is none.");
+    register_property(
+        checkpoint_interval, "checkpoint_interval",
+        "Seconds between two checkpoints. Default is 600.");
+    register_property(
+        checkpoint_depth, "checkpoint_depth",
+        "Deepest subtree of the search tree recorded in a checkpoint. "
+        "Default is 3.");
+    register_property(
+        resume_from, "resume_from",
+        "Checkpoint to resume the branch and bound from, skipping the "
+        "subtrees it completed. Default is none.");
+    register_property(
+        initial_solution, "initial_solution",
+        "Solution, e.g. a previous admission.out, to start the branch and "
+        "bound with if it solves the face DAG. Default is none.");
+    register_property(
+        decompose, "decompose",
+        "Solve the weakly connected components of the face DAG separately. "
+        "Default is 0.");
+    register_property(
+        lower_bound_name, "lower_bound_name",
+        "Lower bound of the branch and bound and best-first optimizers "
+        "(SimpleMinAccCostBound, MinMulCostBound, which requires "
+        "preaccumulate_all 1, or LowerBoundPortfolio). Default is "
+        "SimpleMinAccCostBound.");
+    register_property(
+        lower_bound_portfolio, "lower_bound_portfolio",
+        "Comma-separated lower bounds combined by the LowerBoundPortfolio. "
+        "Default is SimpleMinAccCostBound.");
   }
 };
 
@@ -175,9 +290,43 @@ int main(int argc, char* argv[])
   // Create a lower bound if needed.
   if (op->has_lower_bound())
   {
-    op->set_lower_bound(new admission::SimpleMinAccCostBound());
+    std::vector<std::string> names{p.lower_bound_name};
+    if (p.lower_bound_name == "LowerBoundPortfolio")
+    {
+      std::stringstream list(p.lower_bound_portfolio);
+      for (std::string name; std::getline(list, name, ',');)
+      {
+        names.push_back(name);
+      }
+    }
+    if (std::count(names.begin(), names.end(), "MinMulCostBound") &&
+        !p.preaccumulate_all)
+    {
+      std::cout << "MinMulCostBound requires preaccumulate_all 1."
+                << std::endl;
+      return -1;
+    }
+    static auto lower_bound_factory = admission::LowerBoundFactory::instance();
+    try
+    {
+      admission::LowerBound* lb = lower_bound_factory->construct(names[0]);
+      op->set_lower_bound(lb);
+      if (auto pf = dynamic_cast<admission::LowerBoundPortfolio*>(lb))
+      {
+        for (size_t i = 1; i < names.size(); ++i)
+        {
+          pf->add(lower_bound_factory->construct(names[i]));
+        }
+      }
+    }
+    catch (admission::KeyNotRegisteredError& tnr)
+    {
+      std::cout << tnr.what() << std::endl;
+      return -1;
+    }
     op->set_output_interval(p.solution_output_interval);
     op->set_output_mode(p.human_readable);
+    op->set_progress_path(p.progress_json_path);
   }
 
   // Set the optimizer settings.
@@ -188,11 +337,45 @@ int main(int argc, char* argv[])
   }
   op->set_diagnostics(p.diagnostics);
 
+  // Set the branch and bound settings.
+  if (auto bnb = dynamic_cast<admission::BranchAndBound*>(op))
+  {
+    try
+    {
+      bnb->set_transposition_table(
+          p.tt_size, admission::to_tt_replacement(p.tt_policy));
+      bnb->set_execution_mode(admission::to_bnb_mode(p.bnb_mode));
+      bnb->set_partial_order_reduction(p.partial_order_reduction);
+      admission::HeuristicPolicy& h = bnb->heuristic_policy();
+      h.set_mode(admission::to_heuristic_mode(p.heuristic_policy));
+      h.set_depth(p.heuristic_depth);
+      h.set_min_subtree(p.heuristic_min_subtree);
+      h.set_window(p.heuristic_window);
+      h.set_reuse(p.heuristic_reuse);
+      bnb->set_probes(p.search_space_probes);
+      bnb->set_probe_budget(p.search_space_probe_budget);
+      bnb->set_checkpoint(
+          p.checkpoint_path, p.checkpoint_interval, p.checkpoint_depth);
+      bnb->set_resume(p.resume_from);
+      bnb->set_initial_solution(p.initial_solution);
+    }
+    catch (std::runtime_error& e)
+    {
+      std::cout << e.what() << std::endl;
+      return -1;
+    }
+  }
+  if (auto bf = dynamic_cast<admission::BestFirstOptimizer*>(op))
+  {
+    bf->set_memory_budget(p.best_first_memory);
+  }
+
   // Solve and write the solution and timings to console.
   std::cout << "Planning AD Mission...\n";
 
   auto time = omp_get_wtime();
-  auto seq = op->solve(*g_f);
+  auto seq = p.decompose ? admission::solve_components(*op, *g_f) :
+                          op->solve(*g_f);
   time = omp_get_wtime() - time;
   std::cout << std::endl
             << "Done after " << time << "s"
@@ -210,6 +393,14 @@ int main(int argc, char* argv[])
   {
     op->write(std::cout);
   }
+  if (op->has_lower_bound())
+  {
+    if (auto pf = dynamic_cast<const admission::LowerBoundPortfolio*>(
+            op->get_lower_bound()))
+    {
+      pf->write(std::cout);
+    }
+  }
 
   if (p.preaccumulate_all == true)
   {
@@ -6,6 +6,7 @@
 #include "admission_config.hpp"
 #include "graph/DAG.hpp"
 #include "graph/neighbors.hpp"
+#include "graph/trail.hpp"
 #include "operations/find_eliminations.hpp"
 
 #include <boost/foreach.hpp>
@@ -101,35 +102,39 @@ std::tuple<bool, bool, VertexDesc> check_absorption(
   ADM_DEBUG(eliminate_edge_detail_v) << "Absorbing or filling in result of "
                                      << ij << " -- " << jk << std::endl;
 
-  // Loop over all predecessors of all successors of jk...
-  BOOST_FOREACH(auto oe, out_edges(jk, g))
+  // Every vertex (i,*,k) with S(i,*,k) = S(j,*,k) is a predecessor of
+  // all successors of jk, so we only look at those of the successor
+  // with the fewest predecessors. They are ordered as in all other
+  // in-edge sets, so the last accumulated and the first candidate
+  // are the same as if we looped over all successors.
+  if (!out_degree(jk, g))
   {
-    VertexDesc kl = target(oe, g);
-    //  .. and all predecessors of all successors of jk.
-    BOOST_FOREACH(auto ie, in_edges(kl, g))
+    return std::make_tuple(exists, is_preacc, res);
+  }
+  VertexDesc kl = rarest_neighbor<FaceDAG, upper_accessor>(g, jk);
+  BOOST_FOREACH(auto ie, in_edges(kl, g))
+  {
+    VertexDesc ik = source(ie, g);
+    // Skip if the predecessor of the successor is jk itself.
+    if (jk == ik)
+    {
+      continue;
+    }
+
+    // (1.) Condition for generation of fill-in.
+    // P(i,*,k) = P(i,*,j) && S(i,*,k) = S(j,*,k)
+    if (same_successors(g, jk, ik) && same_predecessors(g, ij, ik))
     {
-      VertexDesc ik = source(ie, g);
-      // Skip if the predecessor of the successor is jk itself.
-      if (jk == ik)
+      if (get(boost::vertex_acc_stat, g, ik))
       {
-        continue;
+        exists = true;
+        is_preacc = true;
+        res = ik;
       }
-
-      // (1.) Condition for generation of fill-in.
-      // P(i,*,k) = P(i,*,j) && S(i,*,k) = S(j,*,k)
-      if (same_predecessors(g, ij, ik) && same_successors(g, jk, ik))
+      else if (!exists && !is_preacc)
       {
-        if (get(boost::vertex_acc_stat, g, ik))
-        {
-          exists = true;
-          is_preacc = true;
-          res = ik;
-        }
-        else if (!exists && !is_preacc)
-        {
-          exists = true;
-          res = ik;
-        }
+        exists = true;
+        res = ik;
       }
     }
   }
@@ -145,8 +150,9 @@ class EliminationAlgorithm
   /**\brief Constructor.
    *
    * @param[inout] g The face DAG to modify.
+   * @param[inout] trail Records all modifications of g if not nullptr.
    */
-  EliminationAlgorithm(FaceDAG& g) : _g(g) {}
+  EliminationAlgorithm(FaceDAG& g, Trail* trail) : _g(g), _trail(trail) {}
 
   ADM_ALWAYS_INLINE
   void merge_vertices(const VertexDesc from, const VertexDesc into);
@@ -160,9 +166,33 @@ class EliminationAlgorithm
   ADM_ALWAYS_INLINE
   void remove_or_merge(const VertexDesc ij);
 
+  /// Isolates a vertex and records its edges in the trail.
+  ADM_ALWAYS_INLINE
+  void isolate(const VertexDesc ij)
+  {
+    if (_trail)
+    {
+      _trail->clearing_vertex(ij, _g);
+    }
+    clear_vertex(ij, _g);
+  }
+
+  /// Records the properties of a vertex in the trail before they are changed.
+  ADM_ALWAYS_INLINE
+  void record_vertex(const VertexDesc ij)
+  {
+    if (_trail)
+    {
+      _trail->putting_vertex(ij, _g);
+    }
+  }
+
  protected:
   /// The face DAG w operate on.
   FaceDAG& _g;
+
+  /// Undo log of the modifications of _g. May be nullptr.
+  Trail* _trail;
 };
 
 /**\brief Eliminates an edge \f$(i,j,k)\f$ from the face DAG g according
@@ -174,17 +204,20 @@ class EliminationAlgorithm
 class EliminateEdge : public EliminationAlgorithm
 {
  public:
-  EliminateEdge(const EdgeDesc ijk, FaceDAG& g)
-      : EliminateEdge(source(ijk, g), target(ijk, g), g)
+  EliminateEdge(const EdgeDesc ijk, FaceDAG& g, Trail* trail = nullptr)
+      : EliminateEdge(source(ijk, g), target(ijk, g), g, trail)
   {}
 
   /**Executes the steps from (Rule 2).
    * @param[in] ij VertexDesc of the source of \f$(i,j,k)\f$.
    * @param[in] jk VertexDesc of the target of \f$(i,j,k)\f$.
    * @param[in] g  Reference to the face DAG.
+   * @param[inout] trail Records all modifications of g if not nullptr.
    */
-  EliminateEdge(const VertexDesc ij, const VertexDesc jk, FaceDAG& g)
-      : EliminationAlgorithm(g)
+  EliminateEdge(
+      const VertexDesc ij, const VertexDesc jk, FaceDAG& g,
+      Trail* trail = nullptr)
+      : EliminationAlgorithm(g, trail)
   {
 #ifndef NDEBUG
     bool success;
@@ -196,6 +229,10 @@ class EliminateEdge : public EliminationAlgorithm
 #endif  // NDEBUG
 
     // Store the indices \f$(i,j,k)\f$ of the eliminated face as a property of the face DAG.
+    if (_trail)
+    {
+      _trail->setting_previous_op(_g);
+    }
     boost::set_property(_g, boost::graph_previous_op, index_triple(ij, jk, g));
 
     // (1.)
@@ -213,6 +250,10 @@ class EliminateEdge : public EliminationAlgorithm
     // We are not actually computing any Jacobians here.
 
     // (3.)
+    if (_trail)
+    {
+      _trail->removing_edge(edge(ij, jk, _g).first, _g);
+    }
     remove_edge(ij, jk, _g);
 
     // (4.)
@@ -232,8 +273,9 @@ class Preaccumulate : public EliminationAlgorithm
 {
  public:
   Preaccumulate(
-      const VertexDesc ij, FaceDAG& g, const bool remove_models = false)
-      : EliminationAlgorithm(g)
+      const VertexDesc ij, FaceDAG& g, const bool remove_models = false,
+      Trail* trail = nullptr)
+      : EliminationAlgorithm(g, trail)
   {
     // Check if \f$\exists (i',j')\f$ such that \f$P(i',j') = P(i,j)\f$
     // and \f$S(i',j') = S(i,j)\f$ and \f$F'(i',j') != \emptyset\f$
@@ -249,6 +291,7 @@ class Preaccumulate : public EliminationAlgorithm
     else
     {
       // (1.)
+      record_vertex(ij);
       put(boost::vertex_acc_stat, _g, ij, true);
       if (remove_models == true)
       {
@@ -268,6 +311,7 @@ ADM_ALWAYS_INLINE
 void EliminationAlgorithm::absorb(
     const VertexDesc ij, const VertexDesc jk, const VertexDesc ik)
 {
+  record_vertex(ik);
   // Set c_tan(i,*,k) to zero.
   put(boost::vertex_c_tan, _g, ik, 0);
   // Set c_adj(i,*,k) to zero.
@@ -296,12 +340,20 @@ void EliminationAlgorithm::fill_in(const VertexDesc ij, const VertexDesc jk)
 
   // Add (i,*,j,*,k) to g.
   VertexDesc ik = add_vertex(_g);
+  if (_trail)
+  {
+    _trail->added_vertex(ik);
+  }
 
   // Add all required edges to ik such
   // that S(i,*,j,*,k) = S(j,*,k).
   BOOST_FOREACH(auto oe, out_edges(jk, _g))
   {
     auto new_e = add_edge(ik, target(oe, _g), _g);
+    if (_trail)
+    {
+      _trail->added_edge(ik, target(oe, _g));
+    }
     put(boost::edge_index, _g, new_e.first, get(boost::edge_index, _g, oe));
     put(boost::edge_size, _g, new_e.first, get(boost::edge_size, _g, oe));
   }
@@ -311,6 +363,10 @@ void EliminationAlgorithm::fill_in(const VertexDesc ij, const VertexDesc jk)
   BOOST_FOREACH(auto ie, in_edges(ij, _g))
   {
     auto new_e = add_edge(source(ie, _g), ik, _g);
+    if (_trail)
+    {
+      _trail->added_edge(source(ie, _g), ik);
+    }
     put(boost::edge_index, _g, new_e.first, get(boost::edge_index, _g, ie));
     put(boost::edge_size, _g, new_e.first, get(boost::edge_size, _g, ie));
   }
@@ -338,6 +394,7 @@ void EliminationAlgorithm::merge_vertices(
   ADM_DEBUG(eliminate_edge_detail_v)
       << "Merging vertex " << from << " into " << into << std::endl;
 
+  record_vertex(into);
   // F'(i,*,j,*,k) != \emptyset.
   put(boost::vertex_has_model, _g, into, false);
   // \dot F(i,*,j,*,k) = \bar F(i,*,j,*,k) = \emptyset.
@@ -346,7 +403,7 @@ void EliminationAlgorithm::merge_vertices(
   // Isolate the vertex in both directions but not remove it,
   // saving us from copying elements of the vector storage
   // used by the FaceDAG class.
-  clear_vertex(from, _g);
+  isolate(from);
 }
 
 /**\brief (Rule 2) (4. and 5.) Removes a vertex (i,*,j) if it is bottom- or
@@ -368,7 +425,7 @@ void EliminationAlgorithm::remove_or_merge(const VertexDesc ij)
     // Isolate the vertex in both directions but not remove it,
     // saving us from copying elements of the vector storage
     // used by the FaceDAG class.
-    clear_vertex(ij, _g);
+    isolate(ij);
     ADM_DEBUG(eliminate_edge_detail_v) << "Removed vertex " << ij << std::endl;
   }
   // ElseIf F'(i,*,j) = \emptyset. We do nothing.
@@ -380,28 +437,25 @@ void EliminationAlgorithm::remove_or_merge(const VertexDesc ij)
   // ElseIf F'(i,*,j) != \emptyset. We try to merge.
   else
   {
-    // Iterate over all successors (j,k) of (i,j)
-    BOOST_FOREACH(auto oe, out_edges(ij, _g))
+    // Iterate over the predecessors (h,j) of the successor (j,k) of (i,j)
+    // with the fewest predecessors. Any vertex with S(*,j) = S(i,*,j)
+    // is among them.
+    VertexDesc jk = rarest_neighbor<FaceDAG, upper_accessor>(_g, ij);
+    BOOST_FOREACH(auto ie, in_edges(jk, _g))
     {
-      VertexDesc jk = target(oe, _g);
-
-      // ... and over all predecessors (h,j) of all successors (j,k).
-      BOOST_FOREACH(auto ie, in_edges(jk, _g))
+      VertexDesc hj = source(ie, _g);
+      if (hj == ij)
       {
-        VertexDesc hj = source(ie, _g);
-        if (hj == ij)
-        {
-          continue;
-        }
+        continue;
+      }
 
-        // Check if succ. set and pred. set of j and v are identical
-        // P(i,*,j) = P(*,j) && S(i,*,j) = S(*,j) && F'(*,j) != \emptyset
-        if (same_predecessors(_g, hj, ij) && same_successors(_g, hj, ij) &&
-            get(boost::vertex_acc_stat, _g, hj))
-        {
-          merge_vertices(hj, ij);
-          return;
-        }
+      // Check if succ. set and pred. set of j and v are identical
+      // P(i,*,j) = P(*,j) && S(i,*,j) = S(*,j) && F'(*,j) != \emptyset
+      if (same_successors(_g, hj, ij) && same_predecessors(_g, hj, ij) &&
+          get(boost::vertex_acc_stat, _g, hj))
+      {
+        merge_vertices(hj, ij);
+        return;
       }
     }
   }
@@ -413,10 +467,12 @@ void EliminationAlgorithm::remove_or_merge(const VertexDesc ij)
  *        Jacobians and no tangent or adjoint models.
  *
  * @param[inout] g Reference to the DAG.
- * @returns OpSequence containing all preaccumulations.
+ * @param[in] remove_models Also remove the tangent and adjoint models.
+ * @param[inout] trail Records all modifications of g if not nullptr.
  */
 ADM_ALWAYS_INLINE
-void preaccumulate_all(FaceDAG& g, bool remove_models = false)
+void preaccumulate_all(
+    FaceDAG& g, bool remove_models = false, Trail* trail = nullptr)
 {
   auto Fprime_exists = boost::get(boost::vertex_acc_stat, g);
   auto Fbardot_exists = boost::get(boost::vertex_has_model, g);
@@ -426,7 +482,7 @@ void preaccumulate_all(FaceDAG& g, bool remove_models = false)
     if (in_degree(ij, g) && out_degree(ij, g) && (!Fprime_exists[ij]) &&
         Fbardot_exists[ij])
     {
-      Preaccumulate(ij, g, remove_models);
+      Preaccumulate(ij, g, remove_models, trail);
     }
   }
 }
@@ -4,6 +4,8 @@
 // ******************************** Includes ******************************** //
 
 #include "admission_config.hpp"
+#include "graph/dag_properties.hpp"
+#include "graph/flat_face_dag.hpp"
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_selectors.hpp>
@@ -29,68 +31,6 @@ struct upper_accessor;
  * @{
  */
 
-/**\brief Repetition of boost macro for jointly defining
- * a property and installing it.
- *
- * Calling the version contained in boost results in an error
- * for some reason. Boost's internal calls to it work, however.
- */
-#define ADM_DEF_PROPERTY(KIND, NAME)                                           \
-  enum KIND##_##NAME##_t{KIND##_##NAME};                                       \
-  BOOST_INSTALL_PROPERTY(KIND, NAME);
-
-namespace boost
-{
-
-// ------------------- Custom properties of DAG vertices -------------------- //
-
-/// Size of a vertex i, denoted n(i) in formulas.
-ADM_DEF_PROPERTY(vertex, size);
-
-// ---------------- Custom properties of Face DAG vertices ------------------ //
-
-/// Cost for an execution of the vector-adjoint model of \f$F_{ij}\f$, denoted  \f$c_{a}(ij)\f$ in formulas.
-ADM_DEF_PROPERTY(vertex, c_adj);
-/// Cost for an execution of the vector-tangent model of \f$F_{ij}\f$, denoted  \f$c_{t}(ij)\f$ in formulas.
-ADM_DEF_PROPERTY(vertex, c_tan);
-/// Indicates whether \f$F'_ij\f$ has been preaccumulated.
-ADM_DEF_PROPERTY(vertex, acc_stat);
-/// Indicates whether the models \f$\bar F_{ij} and \dot F_{ij}\f$ exist.
-ADM_DEF_PROPERTY(vertex, has_model);
-
-// -------------------- Custom properties of DAG edges ---------------------- //
-
-/// Cost for an execution of the vector-adjoint model of \f$F_{ij}\f$, denoted \f$c_a(ij)\f$ in formulas.
-ADM_DEF_PROPERTY(edge, c_adj);
-/// Cost for an execution of the vector-tangent model of \f$F_{ij}\f$, denoted \f$c_t(ij)\f$ in formulas.
-ADM_DEF_PROPERTY(edge, c_tan);
-/// Indicates whether \f$F'_{ij}\f$ has been preaccumulated.
-ADM_DEF_PROPERTY(edge, acc_stat);
-/// Indicates whether the models \f$\bar F_{ij}\f$ and \f$\dot F_{ij}\f$ exist.
-ADM_DEF_PROPERTY(edge, has_model);
-
-// ------------------ Custom properties of Face DAG edges ------------------- //
-
-/// Size of a vertex \f$j \in V\f$ corresponding to an edge \f$(i,j,k) \in \tilde E\f$, denoted \f$n(i)\f$.
-ADM_DEF_PROPERTY(edge, size);
-
-// ---------------- Custom properties of DAGs and FaceDAGs ------------------ //
-
-/// Identifier of the elimination that was used to generate a face DAG.
-ADM_DEF_PROPERTY(graph, previous_op);
-
-// --------------------- Custom property for MetaDAGs ----------------------- //
-
-/// Denotes the current optimal solution's cost.
-ADM_DEF_PROPERTY(graph, opt);
-
-// ------------------ Custom property of MetaDAG vertices ------------------- //
-
-/// A hash to reference the face DAG corresponding to a vertex of a meta DAG.
-ADM_DEF_PROPERTY(vertex, info);
-
-}  // end namespace boost
-
 namespace admission
 {
 
@@ -162,10 +102,21 @@ using DAGBase = boost::adjacency_list<
  */
 using DAG = DAGBase<DAGVertex, DAGEdge, boost::no_property>;
 
-/**\brief The Face DAG class with respective properties attached
- *        to its vertices and edges.
+/**\brief The Face DAG class based on boost::adjacency_list with respective
+ *        properties attached to its vertices and edges.
+ */
+using BoostFaceDAG = DAGBase<FaceDAGVertex, FaceDAGEdge, FaceDAGProperties>;
+
+/**\brief The Face DAG class all algorithms operate on.
+ *
+ * The FlatFaceDAG if ADMission is configured with ADM_FLAT_FACE_DAG,
+ * the BoostFaceDAG otherwise.
  */
-using FaceDAG = DAGBase<FaceDAGVertex, FaceDAGEdge, FaceDAGProperties>;
+#ifdef ADM_FLAT_FACE_DAG
+using FaceDAG = FlatFaceDAG;
+#else
+using FaceDAG = BoostFaceDAG;
+#endif
 
 /**\brief Bundled property of a meta DAG vertex \f$v \in V_m\f$
  *
@@ -198,8 +149,13 @@ using GraphContTraits = boost::adjacency_list_traits<
 /**\brief VertexDesc which is equivalent to an unsigned integer. */
 using VertexDesc = GraphContTraits::vertex_descriptor;
 
-/**\brief EdgeDesc which is some obscure iterator over a list. */
-using EdgeDesc = GraphContTraits::edge_descriptor;
+/**\brief DAGEdgeDesc which is some obscure iterator over a list. */
+using DAGEdgeDesc = GraphContTraits::edge_descriptor;
+
+/**\brief EdgeDesc of the FaceDAG. Identical to DAGEdgeDesc, unless
+ *        the FlatFaceDAG is used.
+ */
+using EdgeDesc = boost::graph_traits<FaceDAG>::edge_descriptor;
 
 /**\brief Wrapper for returning the index of an edge,
  *        relieving us from the boost::get syntax.
@@ -0,0 +1,40 @@
+#ifndef GRAPH_COMPONENTS_HPP
+#define GRAPH_COMPONENTS_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+
+#include <memory>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup DagInfo
+ * @{
+ */
+
+/**\brief Splits a face DAG into its weakly connected components.
+ *
+ * Isolated vertices, i.e. vertices that were merged or
+ * eliminated, are dropped. The vertices of every component
+ * keep their relative order and all their properties.
+ *
+ * Complexity O(|V|+|E|).
+ * @param[in] g Const reference to the face DAG.
+ * @returns The components of g, ordered by their first vertex in g.
+ */
+std::vector<std::shared_ptr<FaceDAG>> split_components(const FaceDAG& g);
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // GRAPH_COMPONENTS_HPP
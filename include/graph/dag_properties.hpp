@@ -0,0 +1,82 @@
+#ifndef DAG_PROPERTIES_HPP
+#define DAG_PROPERTIES_HPP
+
+// ******************************** Includes ******************************** //
+
+#include <boost/graph/properties.hpp>
+#include <boost/pending/property.hpp>
+
+// **************************** Header contents ***************************** //
+
+/**
+ * \addtogroup Dag
+ * @{
+ */
+
+/**\brief Repetition of boost macro for jointly defining
+ * a property and installing it.
+ *
+ * Calling the version contained in boost results in an error
+ * for some reason. Boost's internal calls to it work, however.
+ */
+#define ADM_DEF_PROPERTY(KIND, NAME)                                           \
+  enum KIND##_##NAME##_t{KIND##_##NAME};                                       \
+  BOOST_INSTALL_PROPERTY(KIND, NAME);
+
+namespace boost
+{
+
+// ------------------- Custom properties of DAG vertices -------------------- //
+
+/// Size of a vertex i, denoted n(i) in formulas.
+ADM_DEF_PROPERTY(vertex, size);
+
+// ---------------- Custom properties of Face DAG vertices ------------------ //
+
+/// Cost for an execution of the vector-adjoint model of \f$F_{ij}\f$, denoted  \f$c_{a}(ij)\f$ in formulas.
+ADM_DEF_PROPERTY(vertex, c_adj);
+/// Cost for an execution of the vector-tangent model of \f$F_{ij}\f$, denoted  \f$c_{t}(ij)\f$ in formulas.
+ADM_DEF_PROPERTY(vertex, c_tan);
+/// Indicates whether \f$F'_ij\f$ has been preaccumulated.
+ADM_DEF_PROPERTY(vertex, acc_stat);
+/// Indicates whether the models \f$\bar F_{ij} and \dot F_{ij}\f$ exist.
+ADM_DEF_PROPERTY(vertex, has_model);
+
+// -------------------- Custom properties of DAG edges ---------------------- //
+
+/// Cost for an execution of the vector-adjoint model of \f$F_{ij}\f$, denoted \f$c_a(ij)\f$ in formulas.
+ADM_DEF_PROPERTY(edge, c_adj);
+/// Cost for an execution of the vector-tangent model of \f$F_{ij}\f$, denoted \f$c_t(ij)\f$ in formulas.
+ADM_DEF_PROPERTY(edge, c_tan);
+/// Indicates whether \f$F'_{ij}\f$ has been preaccumulated.
+ADM_DEF_PROPERTY(edge, acc_stat);
+/// Indicates whether the models \f$\bar F_{ij}\f$ and \f$\dot F_{ij}\f$ exist.
+ADM_DEF_PROPERTY(edge, has_model);
+
+// ------------------ Custom properties of Face DAG edges ------------------- //
+
+/// Size of a vertex \f$j \in V\f$ corresponding to an edge \f$(i,j,k) \in \tilde E\f$, denoted \f$n(i)\f$.
+ADM_DEF_PROPERTY(edge, size);
+
+// ---------------- Custom properties of DAGs and FaceDAGs ------------------ //
+
+/// Identifier of the elimination that was used to generate a face DAG.
+ADM_DEF_PROPERTY(graph, previous_op);
+
+// --------------------- Custom property for MetaDAGs ----------------------- //
+
+/// Denotes the current optimal solution's cost.
+ADM_DEF_PROPERTY(graph, opt);
+
+// ------------------ Custom property of MetaDAG vertices ------------------- //
+
+/// A hash to reference the face DAG corresponding to a vertex of a meta DAG.
+ADM_DEF_PROPERTY(vertex, info);
+
+}  // end namespace boost
+
+/**
+ * @}
+ */
+
+#endif  // DAG_PROPERTIES_HPP
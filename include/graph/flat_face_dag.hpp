@@ -0,0 +1,912 @@
+#ifndef FLAT_FACE_DAG_HPP
+#define FLAT_FACE_DAG_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/dag_properties.hpp"
+#include "misc/mix.hpp"
+
+#include <boost/container/vector.hpp>
+#include <boost/foreach.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Dag
+ * @{
+ */
+
+/**\brief Edge descriptor of a FlatFaceDAG, the pair of its end points.
+ *
+ * Unlike the edge descriptors of boost::adjacency_list, two descriptors
+ * compare equal iff they describe the same edge.
+ */
+struct FlatEdgeDesc
+{
+  size_t src = 0;
+  size_t tgt = 0;
+
+  bool operator==(const FlatEdgeDesc& o) const
+  {
+    return src == o.src && tgt == o.tgt;
+  }
+
+  bool operator!=(const FlatEdgeDesc& o) const
+  {
+    return !(*this == o);
+  }
+
+  bool operator<(const FlatEdgeDesc& o) const
+  {
+    return src < o.src || (src == o.src && tgt < o.tgt);
+  }
+};
+
+class FlatFaceDAG;
+
+/**\brief Iterator over the out-edges (Out == true) or in-edges (Out == false)
+ * of a vertex of a FlatFaceDAG.
+ *
+ * Walks the sorted adjacency array of the vertex by position and yields
+ * FlatEdgeDescs by value. Like the iterators of the boost::adjacency_list,
+ * it stays valid if edges of other vertices are added or removed, even if
+ * this moves the adjacency arrays in memory.
+ */
+template<bool Out>
+class FlatIncidenceIterator
+    : public boost::iterator_facade<
+          FlatIncidenceIterator<Out>, FlatEdgeDesc,
+          boost::random_access_traversal_tag, FlatEdgeDesc>
+{
+ public:
+  FlatIncidenceIterator() = default;
+  FlatIncidenceIterator(const FlatFaceDAG* g, const size_t v, const size_t k)
+      : _g(g), _v(v), _k(k)
+  {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  inline FlatEdgeDesc dereference() const;
+
+  bool equal(const FlatIncidenceIterator& o) const
+  {
+    return _k == o._k;
+  }
+
+  void increment()
+  {
+    ++_k;
+  }
+
+  void decrement()
+  {
+    --_k;
+  }
+
+  void advance(const std::ptrdiff_t n)
+  {
+    _k += n;
+  }
+
+  std::ptrdiff_t distance_to(const FlatIncidenceIterator& o) const
+  {
+    return static_cast<std::ptrdiff_t>(o._k) -
+           static_cast<std::ptrdiff_t>(_k);
+  }
+
+  const FlatFaceDAG* _g = nullptr;
+  size_t _v = 0;
+  size_t _k = 0;
+};
+
+/**\brief Scrambled bits of a vertex descriptor.
+ *
+ * The signature of a neighbour set is the sum of the scrambled bits of its
+ * members, so it can be updated in O(1) if a member is added or removed.
+ */
+ADM_ALWAYS_INLINE uint64_t vertex_signature(const size_t v)
+{
+  return mix(static_cast<uint64_t>(v));
+}
+
+/**\brief Iterator over all edges of a FlatFaceDAG, ordered by source
+ * and target.
+ */
+class FlatEdgeIterator
+    : public boost::iterator_facade<
+          FlatEdgeIterator, FlatEdgeDesc, boost::forward_traversal_tag,
+          FlatEdgeDesc>
+{
+ public:
+  FlatEdgeIterator() = default;
+  inline FlatEdgeIterator(const FlatFaceDAG* g, const size_t v);
+
+ private:
+  friend class boost::iterator_core_access;
+
+  inline FlatEdgeDesc dereference() const;
+
+  bool equal(const FlatEdgeIterator& o) const
+  {
+    return _v == o._v && _k == o._k;
+  }
+
+  inline void increment();
+
+  /// Moves to the first vertex from _v on that has out-edges.
+  inline void skip_empty();
+
+  const FlatFaceDAG* _g = nullptr;
+  size_t _v = 0;
+  size_t _k = 0;
+};
+
+/**\brief Property map of a FlatFaceDAG.
+ *
+ * Refers to one of the property arrays of the face DAG, so the map stays
+ * valid if vertices are added. Edge properties are stored per source
+ * vertex, see FlatFaceDAG.
+ *
+ * @tparam Vector The (possibly const) property array.
+ * @tparam Key VertexDesc or FlatEdgeDesc.
+ */
+template<typename Vector, typename Key>
+class flat_pmap
+    : public boost::put_get_helper<
+          decltype(std::declval<Vector&>()[0]), flat_pmap<Vector, Key>>
+{
+ public:
+  ///\name Typedefs mimicking the boost::propery_map.
+  ///@{
+  typedef Key key_type;
+  typedef typename Vector::value_type value_type;
+  typedef decltype(std::declval<Vector&>()[0]) reference;
+  typedef boost::lvalue_property_map_tag category;
+  ///@}
+
+  flat_pmap(Vector& v) : _v(&v) {}
+
+  ADM_ALWAYS_INLINE reference operator[](const Key& k) const
+  {
+    return (*_v)[slot(k)];
+  }
+
+ private:
+  ADM_ALWAYS_INLINE static size_t slot(const size_t v)
+  {
+    return v;
+  }
+
+  ADM_ALWAYS_INLINE static size_t slot(const FlatEdgeDesc& e)
+  {
+    return e.src;
+  }
+
+  Vector* _v;
+};
+
+/**\brief Cache-friendly face DAG container and drop-in replacement for the
+ * boost::adjacency_list based BoostFaceDAG.
+ *
+ * The sorted in- and out-neighbour lists of all vertices are slices of a
+ * single pooled array, and all vertex properties are stored as a
+ * structure of arrays. Copying a FlatFaceDAG therefore copies a handful of
+ * contiguous arrays instead of allocating a std::set per vertex and a node
+ * per edge.
+ *
+ * A slice that runs out of capacity is moved to the end of the pool with
+ * twice the capacity. The pool is compacted when more than half of it is
+ * unused.
+ *
+ * All edges leaving a vertex \f$(i,j) \in \tilde V\f$ of a face DAG share the
+ * index j and the size n(j). The edge properties are therefore stored once
+ * per source vertex, and writing the property of one edge writes it for all
+ * edges leaving its source.
+ *
+ * Every vertex also stores the signatures of its predecessor and successor
+ * sets, see vertex_signature(...). They are updated with every inserted
+ * or erased edge, so vertices with different neighbour sets are told apart
+ * in O(1).
+ *
+ * The BGL functions (vertices(...), out_edges(...), add_edge(...),
+ * boost::get(...) etc.) are overloaded for FlatFaceDAG, so all algorithms
+ * written against the BoostFaceDAG work on it.
+ */
+class FlatFaceDAG
+{
+ public:
+  ///\name Typedefs of boost::graph_traits.
+  ///@{
+  typedef size_t vertex_descriptor;
+  typedef FlatEdgeDesc edge_descriptor;
+  typedef boost::integer_range<size_t>::iterator vertex_iterator;
+  typedef FlatIncidenceIterator<true> out_edge_iterator;
+  typedef FlatIncidenceIterator<false> in_edge_iterator;
+  typedef FlatEdgeIterator edge_iterator;
+  typedef boost::bidirectional_tag directed_category;
+  typedef boost::disallow_parallel_edge_tag edge_parallel_category;
+  struct traversal_category : public boost::bidirectional_graph_tag,
+                              public boost::vertex_list_graph_tag,
+                              public boost::edge_list_graph_tag
+  {};
+  typedef size_t vertices_size_type;
+  typedef size_t edges_size_type;
+  typedef size_t degree_size_type;
+  typedef std::tuple<index_t, index_t, index_t> previous_op_type;
+
+  static vertex_descriptor null_vertex()
+  {
+    return std::numeric_limits<vertex_descriptor>::max();
+  }
+  ///@}
+
+  /// Slice of the pool holding the neighbours of a vertex.
+  struct Slice
+  {
+    uint32_t begin = 0;
+    uint32_t size = 0;
+    uint32_t capacity = 0;
+  };
+
+  ///\name Structure.
+  ///@{
+  size_t num_vertices() const
+  {
+    return _out.size();
+  }
+
+  size_t num_edges() const
+  {
+    return _num_edges;
+  }
+
+  const Slice& out(const size_t v) const
+  {
+    return _out[v];
+  }
+
+  const Slice& in(const size_t v) const
+  {
+    return _in[v];
+  }
+
+  const uint32_t* pool() const
+  {
+    return _pool.data();
+  }
+
+  /// Signature of the predecessor set of v.
+  uint64_t in_signature(const size_t v) const
+  {
+    return _in_sig[v];
+  }
+
+  /// Signature of the successor set of v.
+  uint64_t out_signature(const size_t v) const
+  {
+    return _out_sig[v];
+  }
+
+  /// Appends a vertex without edges and with default properties.
+  size_t add_vertex()
+  {
+    _out.emplace_back();
+    _in.emplace_back();
+    _out_sig.push_back(0);
+    _in_sig.push_back(0);
+    _c_tan.push_back(0);
+    _c_adj.push_back(0);
+    _acc_stat.push_back(false);
+    _has_model.push_back(false);
+    _index.push_back(0);
+    _size.push_back(0);
+    return _out.size() - 1;
+  }
+
+  /// Inserts the edge (s, t). Returns false if it existed.
+  bool add_edge(const size_t s, const size_t t)
+  {
+    assert(s < num_vertices() && t < num_vertices());
+    if (!insert(_out[s], t))
+    {
+      return false;
+    }
+    insert(_in[t], s);
+    _out_sig[s] += vertex_signature(t);
+    _in_sig[t] += vertex_signature(s);
+    ++_num_edges;
+    return true;
+  }
+
+  /// Erases the edge (s, t). Returns false if it did not exist.
+  bool remove_edge(const size_t s, const size_t t)
+  {
+    if (!erase(_out[s], t))
+    {
+      return false;
+    }
+    erase(_in[t], s);
+    _out_sig[s] -= vertex_signature(t);
+    _in_sig[t] -= vertex_signature(s);
+    --_num_edges;
+    return true;
+  }
+
+  /// True if the edge (s, t) exists.
+  bool has_edge(const size_t s, const size_t t) const
+  {
+    const uint32_t* b = _pool.data() + _out[s].begin;
+    const uint32_t* e = b + _out[s].size;
+    return std::binary_search(b, e, static_cast<uint32_t>(t));
+  }
+
+  /// Erases all edges incident to v.
+  void clear_vertex(const size_t v)
+  {
+    const uint64_t sig = vertex_signature(v);
+    for (uint32_t k = 0; k < _out[v].size; ++k)
+    {
+      const uint32_t w = _pool[_out[v].begin + k];
+      erase(_in[w], v);
+      _in_sig[w] -= sig;
+    }
+    for (uint32_t k = 0; k < _in[v].size; ++k)
+    {
+      const uint32_t u = _pool[_in[v].begin + k];
+      erase(_out[u], v);
+      _out_sig[u] -= sig;
+    }
+    _num_edges -= _out[v].size + _in[v].size;
+    _out[v].size = 0;
+    _in[v].size = 0;
+    _out_sig[v] = 0;
+    _in_sig[v] = 0;
+  }
+
+  /**\brief Erases the isolated vertex v.
+   *
+   * As with boost::vecS, all vertices after v are renumbered. Erasing the
+   * last vertex is O(1).
+   */
+  void remove_vertex(const size_t v)
+  {
+    assert(!_out[v].size && !_in[v].size && "Vertex is not isolated!");
+    _waste += _out[v].capacity + _in[v].capacity;
+    if (v + 1 != num_vertices())
+    {
+      for (auto* slices : {&_out, &_in})
+      {
+        for (const auto& s : *slices)
+        {
+          for (uint32_t k = s.begin; k < s.begin + s.size; ++k)
+          {
+            _pool[k] -= _pool[k] > v;
+          }
+        }
+      }
+    }
+    _out.erase(_out.begin() + v);
+    _in.erase(_in.begin() + v);
+    _out_sig.erase(_out_sig.begin() + v);
+    _in_sig.erase(_in_sig.begin() + v);
+    if (v != num_vertices())
+    {
+      resign();
+    }
+    _c_tan.erase(_c_tan.begin() + v);
+    _c_adj.erase(_c_adj.begin() + v);
+    _acc_stat.erase(_acc_stat.begin() + v);
+    _has_model.erase(_has_model.begin() + v);
+    _index.erase(_index.begin() + v);
+    _size.erase(_size.begin() + v);
+  }
+  ///@}
+
+  ///\name Property arrays selected by their boost tag.
+  ///@{
+  std::vector<flop_t>& storage(boost::vertex_c_tan_t)
+  {
+    return _c_tan;
+  }
+
+  const std::vector<flop_t>& storage(boost::vertex_c_tan_t) const
+  {
+    return _c_tan;
+  }
+
+  std::vector<flop_t>& storage(boost::vertex_c_adj_t)
+  {
+    return _c_adj;
+  }
+
+  const std::vector<flop_t>& storage(boost::vertex_c_adj_t) const
+  {
+    return _c_adj;
+  }
+
+  boost::container::vector<bool>& storage(boost::vertex_acc_stat_t)
+  {
+    return _acc_stat;
+  }
+
+  const boost::container::vector<bool>& storage(boost::vertex_acc_stat_t) const
+  {
+    return _acc_stat;
+  }
+
+  boost::container::vector<bool>& storage(boost::vertex_has_model_t)
+  {
+    return _has_model;
+  }
+
+  const boost::container::vector<bool>& storage(boost::vertex_has_model_t) const
+  {
+    return _has_model;
+  }
+
+  std::vector<index_t>& storage(boost::edge_index_t)
+  {
+    return _index;
+  }
+
+  const std::vector<index_t>& storage(boost::edge_index_t) const
+  {
+    return _index;
+  }
+
+  std::vector<flop_t>& storage(boost::edge_size_t)
+  {
+    return _size;
+  }
+
+  const std::vector<flop_t>& storage(boost::edge_size_t) const
+  {
+    return _size;
+  }
+
+  previous_op_type& previous_op()
+  {
+    return _previous_op;
+  }
+
+  const previous_op_type& previous_op() const
+  {
+    return _previous_op;
+  }
+  ///@}
+
+ private:
+  /// Inserts x into the sorted slice s. Returns false if x is present.
+  bool insert(Slice& s, const size_t x)
+  {
+    uint32_t* b = _pool.data() + s.begin;
+    uint32_t* pos = std::lower_bound(b, b + s.size, static_cast<uint32_t>(x));
+    if (pos != b + s.size && *pos == x)
+    {
+      return false;
+    }
+    if (s.size == s.capacity)
+    {
+      const size_t offset = pos - b;
+      grow(s);
+      b = _pool.data() + s.begin;
+      pos = b + offset;
+    }
+    std::copy_backward(pos, b + s.size, b + s.size + 1);
+    *pos = static_cast<uint32_t>(x);
+    ++s.size;
+    return true;
+  }
+
+  /// Erases x from the sorted slice s. Returns false if x is not present.
+  bool erase(Slice& s, const size_t x)
+  {
+    uint32_t* b = _pool.data() + s.begin;
+    uint32_t* pos = std::lower_bound(b, b + s.size, static_cast<uint32_t>(x));
+    if (pos == b + s.size || *pos != x)
+    {
+      return false;
+    }
+    std::copy(pos + 1, b + s.size, pos);
+    --s.size;
+    return true;
+  }
+
+  /// Moves s to the end of the pool with twice its capacity.
+  void grow(Slice& s)
+  {
+    if (_waste > 1024 && 2 * _waste > _pool.size())
+    {
+      compact();
+    }
+    const uint32_t capacity = s.capacity ? 2 * s.capacity : 4;
+    const size_t begin = _pool.size();
+    _pool.resize(begin + capacity);
+    std::copy(
+        _pool.begin() + s.begin, _pool.begin() + s.begin + s.size,
+        _pool.begin() + begin);
+    _waste += s.capacity;
+    s.begin = static_cast<uint32_t>(begin);
+    s.capacity = capacity;
+  }
+
+  /// Recomputes all signatures after the vertices were renumbered.
+  void resign()
+  {
+    for (size_t v = 0; v < num_vertices(); ++v)
+    {
+      _out_sig[v] = 0;
+      for (uint32_t k = 0; k < _out[v].size; ++k)
+      {
+        _out_sig[v] += vertex_signature(_pool[_out[v].begin + k]);
+      }
+      _in_sig[v] = 0;
+      for (uint32_t k = 0; k < _in[v].size; ++k)
+      {
+        _in_sig[v] += vertex_signature(_pool[_in[v].begin + k]);
+      }
+    }
+  }
+
+  /// Packs all slices to the front of a new pool, keeping their capacity.
+  void compact()
+  {
+    std::vector<uint32_t> pool;
+    pool.reserve(_pool.size() - _waste);
+    for (auto* slices : {&_out, &_in})
+    {
+      for (auto& s : *slices)
+      {
+        const uint32_t begin = static_cast<uint32_t>(pool.size());
+        pool.insert(
+            pool.end(), _pool.begin() + s.begin,
+            _pool.begin() + s.begin + s.capacity);
+        s.begin = begin;
+      }
+    }
+    _pool.swap(pool);
+    _waste = 0;
+  }
+
+  /// Neighbour lists of all vertices.
+  std::vector<uint32_t> _pool;
+  /// Number of unused entries in _pool.
+  size_t _waste = 0;
+  std::vector<Slice> _out;
+  std::vector<Slice> _in;
+  size_t _num_edges = 0;
+  /// Signatures of the successor and predecessor sets.
+  std::vector<uint64_t> _out_sig;
+  std::vector<uint64_t> _in_sig;
+
+  // Not the packed std::vector<bool>, so the property maps yield bool&.
+  std::vector<flop_t> _c_tan;
+  std::vector<flop_t> _c_adj;
+  boost::container::vector<bool> _acc_stat;
+  boost::container::vector<bool> _has_model;
+  std::vector<index_t> _index;
+  std::vector<flop_t> _size;
+
+  previous_op_type _previous_op;
+};
+
+// --------------- Deferred members of FlatIncidenceIterator ---------------- //
+
+template<bool Out>
+FlatEdgeDesc FlatIncidenceIterator<Out>::dereference() const
+{
+  if (Out)
+  {
+    return FlatEdgeDesc{_v, _g->pool()[_g->out(_v).begin + _k]};
+  }
+  return FlatEdgeDesc{_g->pool()[_g->in(_v).begin + _k], _v};
+}
+
+// ------------------ Deferred members of FlatEdgeIterator ------------------ //
+
+FlatEdgeIterator::FlatEdgeIterator(const FlatFaceDAG* g, const size_t v)
+    : _g(g), _v(v)
+{
+  skip_empty();
+}
+
+FlatEdgeDesc FlatEdgeIterator::dereference() const
+{
+  return FlatEdgeDesc{_v, _g->pool()[_g->out(_v).begin + _k]};
+}
+
+void FlatEdgeIterator::increment()
+{
+  if (++_k == _g->out(_v).size)
+  {
+    _k = 0;
+    ++_v;
+    skip_empty();
+  }
+}
+
+void FlatEdgeIterator::skip_empty()
+{
+  while (_v < _g->num_vertices() && !_g->out(_v).size)
+  {
+    ++_v;
+  }
+}
+
+// ------------------- BGL interface of the FlatFaceDAG --------------------- //
+
+///\name Overloads of the BGL functions for FlatFaceDAG.
+///@{
+ADM_ALWAYS_INLINE size_t num_vertices(const FlatFaceDAG& g)
+{
+  return g.num_vertices();
+}
+
+ADM_ALWAYS_INLINE size_t num_edges(const FlatFaceDAG& g)
+{
+  return g.num_edges();
+}
+
+ADM_ALWAYS_INLINE std::pair<
+    FlatFaceDAG::vertex_iterator, FlatFaceDAG::vertex_iterator>
+vertices(const FlatFaceDAG& g)
+{
+  return {
+      FlatFaceDAG::vertex_iterator(0),
+      FlatFaceDAG::vertex_iterator(g.num_vertices())};
+}
+
+ADM_ALWAYS_INLINE std::pair<FlatEdgeIterator, FlatEdgeIterator> edges(
+    const FlatFaceDAG& g)
+{
+  return {FlatEdgeIterator(&g, 0), FlatEdgeIterator(&g, g.num_vertices())};
+}
+
+ADM_ALWAYS_INLINE std::pair<
+    FlatFaceDAG::out_edge_iterator, FlatFaceDAG::out_edge_iterator>
+out_edges(const size_t v, const FlatFaceDAG& g)
+{
+  return {
+      FlatFaceDAG::out_edge_iterator(&g, v, 0),
+      FlatFaceDAG::out_edge_iterator(&g, v, g.out(v).size)};
+}
+
+ADM_ALWAYS_INLINE std::pair<
+    FlatFaceDAG::in_edge_iterator, FlatFaceDAG::in_edge_iterator>
+in_edges(const size_t v, const FlatFaceDAG& g)
+{
+  return {
+      FlatFaceDAG::in_edge_iterator(&g, v, 0),
+      FlatFaceDAG::in_edge_iterator(&g, v, g.in(v).size)};
+}
+
+ADM_ALWAYS_INLINE size_t out_degree(const size_t v, const FlatFaceDAG& g)
+{
+  return g.out(v).size;
+}
+
+ADM_ALWAYS_INLINE size_t in_degree(const size_t v, const FlatFaceDAG& g)
+{
+  return g.in(v).size;
+}
+
+ADM_ALWAYS_INLINE size_t degree(const size_t v, const FlatFaceDAG& g)
+{
+  return g.in(v).size + g.out(v).size;
+}
+
+ADM_ALWAYS_INLINE size_t source(const FlatEdgeDesc e, const FlatFaceDAG&)
+{
+  return e.src;
+}
+
+ADM_ALWAYS_INLINE size_t target(const FlatEdgeDesc e, const FlatFaceDAG&)
+{
+  return e.tgt;
+}
+
+ADM_ALWAYS_INLINE std::pair<FlatEdgeDesc, bool> edge(
+    const size_t s, const size_t t, const FlatFaceDAG& g)
+{
+  return {FlatEdgeDesc{s, t}, g.has_edge(s, t)};
+}
+
+ADM_ALWAYS_INLINE size_t add_vertex(FlatFaceDAG& g)
+{
+  return g.add_vertex();
+}
+
+ADM_ALWAYS_INLINE std::pair<FlatEdgeDesc, bool> add_edge(
+    const size_t s, const size_t t, FlatFaceDAG& g)
+{
+  const bool inserted = g.add_edge(s, t);
+  return {FlatEdgeDesc{s, t}, inserted};
+}
+
+ADM_ALWAYS_INLINE void remove_edge(
+    const size_t s, const size_t t, FlatFaceDAG& g)
+{
+  g.remove_edge(s, t);
+}
+
+ADM_ALWAYS_INLINE void remove_edge(const FlatEdgeDesc e, FlatFaceDAG& g)
+{
+  g.remove_edge(e.src, e.tgt);
+}
+
+ADM_ALWAYS_INLINE void clear_vertex(const size_t v, FlatFaceDAG& g)
+{
+  g.clear_vertex(v);
+}
+
+ADM_ALWAYS_INLINE void remove_vertex(const size_t v, FlatFaceDAG& g)
+{
+  g.remove_vertex(v);
+}
+///@}
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+namespace boost
+{
+
+/* Make the overloads visible to calls qualified with boost::, as used
+ * by the accessors in DAG.hpp.
+ */
+using admission::add_edge;
+using admission::add_vertex;
+using admission::clear_vertex;
+using admission::degree;
+using admission::edge;
+using admission::edges;
+using admission::in_degree;
+using admission::in_edges;
+using admission::num_edges;
+using admission::num_vertices;
+using admission::out_degree;
+using admission::out_edges;
+using admission::remove_edge;
+using admission::remove_vertex;
+using admission::source;
+using admission::target;
+using admission::vertices;
+
+/// Key type of the property maps of a FlatFaceDAG for a property kind.
+template<typename Kind>
+struct flat_key
+{
+  typedef size_t type;
+};
+
+template<>
+struct flat_key<edge_property_tag>
+{
+  typedef admission::FlatEdgeDesc type;
+};
+
+/// Property map of a FlatFaceDAG for Tag.
+template<typename Tag, typename Graph>
+using flat_pmap_t = admission::flat_pmap<
+    std::remove_reference_t<decltype(std::declval<Graph&>().storage(Tag()))>,
+    typename flat_key<typename property_kind<Tag>::type>::type>;
+
+///\name Property access of a FlatFaceDAG.
+///@{
+template<typename Tag>
+ADM_ALWAYS_INLINE flat_pmap_t<Tag, admission::FlatFaceDAG> get(
+    const Tag t, admission::FlatFaceDAG& g)
+{
+  return g.storage(t);
+}
+
+template<typename Tag>
+ADM_ALWAYS_INLINE flat_pmap_t<Tag, const admission::FlatFaceDAG> get(
+    const Tag t, const admission::FlatFaceDAG& g)
+{
+  return g.storage(t);
+}
+
+ADM_ALWAYS_INLINE typed_identity_property_map<size_t> get(
+    vertex_index_t, const admission::FlatFaceDAG&)
+{
+  return typed_identity_property_map<size_t>();
+}
+
+template<typename Tag, typename Key>
+ADM_ALWAYS_INLINE auto get(
+    const Tag t, const admission::FlatFaceDAG& g, const Key& k)
+    -> decltype(get(t, g)[k])
+{
+  return get(t, g)[k];
+}
+
+template<typename Tag, typename Key, typename Value>
+ADM_ALWAYS_INLINE auto put(
+    const Tag t, admission::FlatFaceDAG& g, const Key& k, const Value& val)
+    -> decltype(void(get(t, g)[k] = val))
+{
+  get(t, g)[k] = val;
+}
+
+ADM_ALWAYS_INLINE admission::FlatFaceDAG::previous_op_type& get_property(
+    admission::FlatFaceDAG& g, graph_previous_op_t)
+{
+  return g.previous_op();
+}
+
+ADM_ALWAYS_INLINE const admission::FlatFaceDAG::previous_op_type& get_property(
+    const admission::FlatFaceDAG& g, graph_previous_op_t)
+{
+  return g.previous_op();
+}
+
+ADM_ALWAYS_INLINE void set_property(
+    admission::FlatFaceDAG& g, graph_previous_op_t,
+    const admission::FlatFaceDAG::previous_op_type& v)
+{
+  g.previous_op() = v;
+}
+///@}
+
+}  // end namespace boost
+
+namespace admission
+{
+
+/**\brief Copies a face DAG into another, possibly of a different
+ * container type, e.g. a BoostFaceDAG into a FlatFaceDAG.
+ *
+ * The VertexDescs of from are preserved in to.
+ * @param[in] from The face DAG to copy.
+ * @param[out] to An empty face DAG.
+ */
+template<typename From, typename To>
+void convert_face_dag(const From& from, To& to)
+{
+  assert(num_vertices(to) == 0 && "Target face DAG is not empty!");
+  BOOST_FOREACH(auto v, vertices(from))
+  {
+    auto w = add_vertex(to);
+    put(boost::vertex_acc_stat, to, w, get(boost::vertex_acc_stat, from, v));
+    put(boost::vertex_has_model, to, w, get(boost::vertex_has_model, from, v));
+    put(boost::vertex_c_tan, to, w, get(boost::vertex_c_tan, from, v));
+    put(boost::vertex_c_adj, to, w, get(boost::vertex_c_adj, from, v));
+  }
+  BOOST_FOREACH(auto e, edges(from))
+  {
+    auto f = add_edge(source(e, from), target(e, from), to).first;
+    put(boost::edge_index, to, f, get(boost::edge_index, from, e));
+    put(boost::edge_size, to, f, get(boost::edge_size, from, e));
+  }
+  set_property(
+      to, boost::graph_previous_op,
+      get_property(from, boost::graph_previous_op));
+}
+
+}  // end namespace admission
+
+#endif  // FLAT_FACE_DAG_HPP
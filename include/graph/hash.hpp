@@ -0,0 +1,68 @@
+#ifndef GRAPH_HASH_HPP
+#define GRAPH_HASH_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+
+#include <stdint.h>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup DagInfo
+ * @{
+ */
+
+/**\brief 128 bit fingerprint of the structure and properties of a face DAG.
+ *
+ * Two lanes are computed with independent seeds, to make accidental
+ * collisions between different face DAGs unlikely.
+ */
+struct FaceDAGHash
+{
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+
+  bool operator==(const FaceDAGHash& o) const
+  {
+    return hi == o.hi && lo == o.lo;
+  }
+
+  bool operator!=(const FaceDAGHash& o) const
+  {
+    return !(*this == o);
+  }
+};
+
+/**\brief Computes a canonical fingerprint of a face DAG.
+ *
+ * The fingerprint does not depend on the VertexDescs of g.
+ * Every vertex \f$(i,j) \in \tilde V\f$ is labelled by its index pair,
+ * its accumulation state, its models and their costs.
+ * The labels are refined once with the labels of all predecessors and
+ * successors (Weisfeiler-Lehman) and summed up commutatively.
+ * Face DAGs that only differ in the numbering of their vertices,
+ * e.g. after applying commuting eliminations in a different order,
+ * therefore yield the same fingerprint. Isolated vertices are ignored.
+ *
+ * \attention The refinement is not a complete graph invariant. Different
+ * face DAGs may share a fingerprint with (very) small probability.
+ *
+ * Complexity O(|V|+|E|).
+ * @param[in] g Const reference to the face DAG.
+ * @returns FaceDAGHash the fingerprint of g.
+ */
+FaceDAGHash face_dag_hash(const FaceDAG& g);
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // GRAPH_HASH_HPP
@@ -10,6 +10,8 @@
 
 #include <algorithm>
 #include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
 
 // **************************** Header contents ***************************** //
 
@@ -23,6 +25,11 @@ namespace admission
 
 /**\brief Counts the number m of shared neighbors of two vertices \f$a,b \in V\f$.
  *
+ * The neighbours of a vertex are ordered by their descriptors, both in the
+ * FlatFaceDAG and in the boost::adjacency_list with boost::setS, so the
+ * neighbour sets are intersected in a single pass.
+ *
+ * Complexity O(|N(a)| + |N(b)|).
  * @tparam dir If Dir == lower_accessor \f$N(x) := P(x)\f$ elseif Dir == upper_accessor \f$N(x) := S(x)\f$.
  * @param[in] g the face DAG.
  * @param[in] a vertex.
@@ -34,22 +41,64 @@ plength_t num_shared_neighbors(
     const G& g, const VertexDesc a, const VertexDesc b)
 {
   size_t same_members = 0;
-  BOOST_FOREACH(auto ea, Dir::edges(a, g))
+  auto [ia, ea] = Dir::edges(a, g);
+  auto [ib, eb] = Dir::edges(b, g);
+  while (ia != ea && ib != eb)
   {
-    BOOST_FOREACH(auto eb, Dir::edges(b, g))
+    const VertexDesc na = Dir::next_vertex(*ia, g);
+    const VertexDesc nb = Dir::next_vertex(*ib, g);
+    if (na < nb)
+    {
+      ++ia;
+    }
+    else if (nb < na)
+    {
+      ++ib;
+    }
+    else
     {
-      if (Dir::next_vertex(ea, g) == Dir::next_vertex(eb, g))
-      {
-        same_members++;
-      }
+      same_members++;
+      ++ia;
+      ++ib;
     }
   }
   return same_members;
 }
 
+/**\brief Signature of the neighbor set \f$N(v)\f$ of a vertex v,
+ *        the sum of the vertex_signature(...) of its members.
+ *
+ * Equal neighbour sets have equal signatures. Complexity O(|N(v)|),
+ * O(1) on a FlatFaceDAG, which stores them.
+ * @tparam dir If Dir == lower_accessor \f$N(x) := P(x)\f$ elseif Dir == upper_accessor \f$N(x) := S(x)\f$.
+ * @param[in] g the (face) DAG.
+ * @param[in] v vertex.
+ * @returns The signature of N(v).
+ */
+template<typename G, typename Dir>
+ADM_ALWAYS_INLINE uint64_t neighbor_signature(const G& g, const VertexDesc v)
+{
+  if constexpr (std::is_same<G, FlatFaceDAG>::value)
+  {
+    return std::is_same<Dir, lower_accessor>::value ? g.in_signature(v) :
+                                                      g.out_signature(v);
+  }
+  else
+  {
+    uint64_t sig = 0;
+    BOOST_FOREACH(auto e, Dir::edges(v, g))
+    {
+      sig += vertex_signature(Dir::next_vertex(e, g));
+    }
+    return sig;
+  }
+}
+
 /**\brief Returns true, if the neighbor sets \f$N(a)\f$ and \f$N(b)\f$
  * of vertices a and b are identical.
  *
+ * Vertices with different degrees or signatures are rejected before the
+ * sets are compared.
  * @tparam dir If Dir == lower_accessor \f$N(x) := P(x)\f$ elseif Dir == upper_accessor \f$N(x) := S(x)\f$.
  * @param g const reference to the face DAG.
  * @param a vertex.
@@ -64,9 +113,44 @@ ADM_ALWAYS_INLINE bool same_neighbors(
   {
     return false;
   }
+  if constexpr (std::is_same<G, FlatFaceDAG>::value)
+  {
+    if (neighbor_signature<G, Dir>(g, a) != neighbor_signature<G, Dir>(g, b))
+    {
+      return false;
+    }
+  }
   return (num_shared_neighbors<G, Dir>(g, a, b) == Dir::degree(a, g));
 }
 
+/**\brief Finds the neighbor \f$w \in N(v)\f$ with the fewest reverse
+ *        neighbors \f$|R(w)|\f$, where R is the reverse of N.
+ *
+ * Every vertex with the same neighbor set as v is in R(w), so
+ * it suffices to search R(w) for such vertices.
+ * @tparam dir If Dir == lower_accessor \f$N(x) := P(x)\f$ elseif Dir == upper_accessor \f$N(x) := S(x)\f$.
+ * @param[in] g the face DAG.
+ * @param[in] v vertex, must have a neighbor.
+ * @returns w.
+ */
+template<typename G, typename Dir>
+ADM_ALWAYS_INLINE VertexDesc rarest_neighbor(const G& g, const VertexDesc v)
+{
+  VertexDesc res = VertexDesc();
+  size_t fewest = 0;
+  BOOST_FOREACH(auto e, Dir::edges(v, g))
+  {
+    const VertexDesc w = Dir::next_vertex(e, g);
+    const size_t d = Dir::reverse::degree(w, g);
+    if (!fewest || d < fewest)
+    {
+      res = w;
+      fewest = d;
+    }
+  }
+  return res;
+}
+
 template<typename Dir>
 bool same_neighbors_but_one(
     const FaceDAG& g, const VertexDesc a, const VertexDesc b,
@@ -35,6 +35,7 @@ class matrix_dim_mismatch : public std::runtime_error
 
 /**\brief reads a graph from the format used in Tamme Claus Seminar Paper.
  * Reads graph from a single file used for optimal matrix product chaining.
+ * The sparsity patterns that may follow the factors are skipped.
  * @param[in]    stream Reference to an ifstream to read data from
  * @param[inout] g Reference to the graph that will represent the problem specified by the file.\ Its expected to be empty.
  */
@@ -60,7 +61,15 @@ void read_graphml(std::ifstream& stream, admission::DAG& g);
  * @param[in] stream Reference to an ifstream to read data from
  * @param[out] g Reference to the graph that will represent the problem specified by the file.\ Its expected to be empty.
  */
-void read_graphml(std::ifstream& stream, admission::FaceDAG& g);
+void read_graphml(std::ifstream& stream, admission::BoostFaceDAG& g);
+
+/**\brief Reads a FlatFaceDAG from a GRAPHML file.
+ *
+ * Reads a BoostFaceDAG and converts it.
+ * @param[in] stream Reference to an ifstream to read data from
+ * @param[out] g Reference to the graph that will represent the problem specified by the file.\ Its expected to be empty.
+ */
+void read_graphml(std::ifstream& stream, admission::FlatFaceDAG& g);
 
 /**
  * \brief Reads a DAG from different formats.
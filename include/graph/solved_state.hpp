@@ -0,0 +1,95 @@
+#ifndef SOLVED_STATE_HPP
+#define SOLVED_STATE_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "graph/trail.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup DagInfo
+ * @{
+ */
+
+/**\brief Counters deciding whether a face DAG is solved, i.e. whether
+ * no elimination or preaccumulation can be applied to it anymore.
+ *
+ * A face DAG is solved if its longest path has length 2 and all its
+ * intermediate vertices are accumulated. A path of length 3 exists iff
+ * there is an edge (ij, jk) with in_degree(ij) > 0 and out_degree(jk) > 0,
+ * so it suffices to count
+ *  - the intermediate vertices,
+ *  - the unaccumulated intermediate vertices and
+ *  - the edges on a path of length 3.
+ *
+ * The counts are kept per vertex, so after a modification of the face DAG
+ * only the vertices it touched have to be passed to update(...).
+ */
+class SolvedState
+{
+ public:
+  SolvedState() = default;
+
+  /// Counts on g. Complexity O(|V|+|E|).
+  explicit SolvedState(const FaceDAG& g);
+
+  /// True if the face DAG is solved. Complexity O(1).
+  ADM_ALWAYS_INLINE bool solved() const
+  {
+    return _intermediate > 0 && _unaccumulated == 0 && _on_long_path == 0;
+  }
+
+  /**\brief Recounts the vertices that were touched by a modification of g.
+   *
+   * A vertex is touched if it was added or removed, its properties changed
+   * or an edge was added to or removed from it. Also works if the
+   * modification was rolled back, with the vertices touched before.
+   * Complexity O(sum of the in-degrees of the touched vertices).
+   * @param[in] g The modified face DAG.
+   * @param[in] touched The touched vertices, possibly repeated.
+   */
+  void update(const FaceDAG& g, const TouchedVertices& touched);
+
+ private:
+  /// Contribution of a single vertex to the counters.
+  struct Counts
+  {
+    bool intermediate = false;
+    bool unaccumulated = false;
+    /// Out-edges of the vertex on a path of length 3.
+    uint32_t on_long_path = 0;
+  };
+
+  /// Counts of v on g.
+  static Counts count(const VertexDesc v, const FaceDAG& g);
+
+  /// Replaces the counts of v by c.
+  void set(const VertexDesc v, const Counts& c);
+
+  std::vector<Counts> _counts;
+  size_t _intermediate = 0;
+  size_t _unaccumulated = 0;
+  size_t _on_long_path = 0;
+
+  /// Vertices to recount by update(...).
+  std::vector<VertexDesc> _region;
+  std::vector<char> _in_region;
+};
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // SOLVED_STATE_HPP
@@ -30,7 +30,14 @@ void write_tikz(std::ostream& out, const DAG& g);
  * @param[inout] out Reference to a std::ostream to which the tikz code is written.
  * @param[in] g const reference to the graph we write.
  */
-void write_tikz(std::ostream& out, const FaceDAG& g);
+void write_tikz(std::ostream& out, const BoostFaceDAG& g);
+
+/**\brief Function to print a FlatFaceDAG to a text-file in TikZ.
+ *
+ * @param[inout] out Reference to a std::ostream to which the tikz code is written.
+ * @param[in] g const reference to the graph we write.
+ */
+void write_tikz(std::ostream& out, const FlatFaceDAG& g);
 
 /**\brief Function to print a MetaDAG to a text-file in TikZ.
  *
@@ -0,0 +1,285 @@
+#ifndef TRAIL_HPP
+#define TRAIL_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "misc/arena.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/properties.hpp>
+
+#include <cassert>
+#include <stddef.h>
+#include <tuple>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup DagMod
+ * @{
+ */
+
+/// Vertices reported by Trail::touched(...), kept in the arena of the search.
+typedef ArenaVector<VertexDesc> TouchedVertices;
+
+/**\brief Undo log of the modifications of a face DAG.
+ *
+ * The EliminationAlgorithms record every modification of a face DAG
+ * in a Trail before they perform it, if they are given one.
+ * rollback(...) restores the face DAG to the state it had when mark()
+ * was called, so a depth-first search can modify a single face DAG
+ * instead of copying it for every branch.
+ *
+ * Vertices are only ever added at the end of the vertex storage and
+ * removed in reverse order, so VertexDescs stay valid across a rollback.
+ */
+class Trail
+{
+ public:
+  /// Position in the log that can be rolled back to.
+  typedef size_t Mark;
+
+  /// Returns the current position in the log.
+  ADM_ALWAYS_INLINE
+  Mark mark() const
+  {
+    return _entries.size();
+  }
+
+  /// True if no modification is logged.
+  ADM_ALWAYS_INLINE
+  bool empty() const
+  {
+    return _entries.empty();
+  }
+
+  ///\name Recording, called before the modification takes place.
+  ///@{
+  /// Vertex v was added as the last vertex of g.
+  ADM_ALWAYS_INLINE
+  void added_vertex(const VertexDesc v)
+  {
+    Entry e;
+    e.kind = AddVertex;
+    e.a = v;
+    _entries.push_back(e);
+  }
+
+  /// Edge (s, t) was added to g.
+  ADM_ALWAYS_INLINE
+  void added_edge(const VertexDesc s, const VertexDesc t)
+  {
+    Entry e;
+    e.kind = AddEdge;
+    e.a = s;
+    e.b = t;
+    _entries.push_back(e);
+  }
+
+  /// Edge ed is about to be removed from g.
+  ADM_ALWAYS_INLINE
+  void removing_edge(const EdgeDesc ed, const FaceDAG& g)
+  {
+    Entry e;
+    e.kind = RemoveEdge;
+    e.a = source(ed, g);
+    e.b = target(ed, g);
+    e.i = boost::get(boost::edge_index, g, ed);
+    e.x = boost::get(boost::edge_size, g, ed);
+    _entries.push_back(e);
+  }
+
+  /// All edges of v are about to be removed from g.
+  ADM_ALWAYS_INLINE
+  void clearing_vertex(const VertexDesc v, const FaceDAG& g)
+  {
+    BOOST_FOREACH(auto ie, in_edges(v, g))
+    {
+      removing_edge(ie, g);
+    }
+    BOOST_FOREACH(auto oe, out_edges(v, g))
+    {
+      removing_edge(oe, g);
+    }
+  }
+
+  /// The properties of vertex v are about to be changed.
+  ADM_ALWAYS_INLINE
+  void putting_vertex(const VertexDesc v, const FaceDAG& g)
+  {
+    Entry e;
+    e.kind = VertexProps;
+    e.a = v;
+    e.acc = boost::get(boost::vertex_acc_stat, g, v);
+    e.model = boost::get(boost::vertex_has_model, g, v);
+    e.x = boost::get(boost::vertex_c_tan, g, v);
+    e.y = boost::get(boost::vertex_c_adj, g, v);
+    _entries.push_back(e);
+  }
+
+  /// The previous_op property of g is about to be changed.
+  ADM_ALWAYS_INLINE
+  void setting_previous_op(const FaceDAG& g)
+  {
+    Entry e;
+    e.kind = PreviousOp;
+    std::tie(e.i, e.j, e.k) = boost::get_property(g, boost::graph_previous_op);
+    _entries.push_back(e);
+  }
+  ///@}
+
+  /**\brief Undoes all modifications recorded after m in reverse order.
+   *
+   * @param[inout] g The face DAG the modifications were recorded on.
+   * @param[in] m Mark to roll back to.
+   */
+  void rollback(FaceDAG& g, const Mark m)
+  {
+    while (_entries.size() > m)
+    {
+      undo(g, _entries.back());
+      _entries.pop_back();
+    }
+  }
+
+  /**\brief Undoes the modifications recorded after m on a copy of the
+   * face DAG they were recorded on. The log is left unchanged.
+   *
+   * @param[inout] h Copy of the face DAG the modifications were recorded on.
+   * @param[in] m Mark to restore the state of.
+   */
+  void restore(FaceDAG& h, const Mark m) const
+  {
+    for (size_t k = _entries.size(); k > m; --k)
+    {
+      undo(h, _entries[k - 1]);
+    }
+  }
+
+  /**\brief Calls f for every vertex that was added, had its properties
+   * changed or had an edge added or removed after m.
+   *
+   * Vertices may be reported more than once.
+   * @param[in] m Mark to start at.
+   * @param[in] f Callable taking a VertexDesc.
+   */
+  template <typename F>
+  void touched(const Mark m, F&& f) const
+  {
+    for (size_t k = m; k < _entries.size(); ++k)
+    {
+      const Entry& e = _entries[k];
+      switch (e.kind)
+      {
+        case AddVertex:
+        case VertexProps:
+        {
+          f(e.a);
+          break;
+        }
+        case AddEdge:
+        case RemoveEdge:
+        {
+          f(e.a);
+          f(e.b);
+          break;
+        }
+        case PreviousOp:
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  /**\brief Drops the modifications recorded after m.
+   *
+   * They can no longer be rolled back.
+   * @param[in] m Mark to drop the modifications after.
+   */
+  void forget(const Mark m)
+  {
+    _entries.erase(_entries.begin() + m, _entries.end());
+  }
+
+ private:
+  /// Kinds of recorded modifications.
+  enum Kind : unsigned char
+  {
+    AddVertex,
+    AddEdge,
+    RemoveEdge,
+    VertexProps,
+    PreviousOp
+  };
+
+  /// A recorded modification with the data required to undo it.
+  struct Entry
+  {
+    Kind kind;
+    bool acc = false;
+    bool model = false;
+    index_t i = 0, j = 0, k = 0;
+    VertexDesc a = 0, b = 0;
+    flop_t x = 0, y = 0;
+  };
+
+  /// Undoes a single recorded modification.
+  static void undo(FaceDAG& g, const Entry& e)
+  {
+    switch (e.kind)
+    {
+      case AddVertex:
+      {
+        assert(
+            e.a + 1 == num_vertices(g) && !in_degree(e.a, g) &&
+            !out_degree(e.a, g) && "Rolled back vertex is not the last.");
+        remove_vertex(e.a, g);
+        break;
+      }
+      case AddEdge:
+      {
+        remove_edge(e.a, e.b, g);
+        break;
+      }
+      case RemoveEdge:
+      {
+        auto new_e = add_edge(e.a, e.b, g).first;
+        put(boost::edge_index, g, new_e, e.i);
+        put(boost::edge_size, g, new_e, e.x);
+        break;
+      }
+      case VertexProps:
+      {
+        put(boost::vertex_acc_stat, g, e.a, e.acc);
+        put(boost::vertex_has_model, g, e.a, e.model);
+        put(boost::vertex_c_tan, g, e.a, e.x);
+        put(boost::vertex_c_adj, g, e.a, e.y);
+        break;
+      }
+      case PreviousOp:
+      {
+        boost::set_property(
+            g, boost::graph_previous_op, std::make_tuple(e.i, e.j, e.k));
+        break;
+      }
+    }
+  }
+
+  std::vector<Entry> _entries;
+};
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // TRAIL_HPP
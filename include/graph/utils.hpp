@@ -8,6 +8,11 @@
 #include <boost/foreach.hpp>
 #include <boost/graph/graph_traits.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <stddef.h>
+#include <vector>
+
 // **************************** Header contents ***************************** //
 
 namespace admission
@@ -18,10 +23,52 @@ namespace admission
  * \defgroup DagInfo Information about the structure of DAGs and FaceDAGs.
  */
 
+namespace detail
+{
+
+/// Marks a vertex whose longest path is not known yet.
+constexpr plength_t unknown_length = std::numeric_limits<plength_t>::max();
+
+/**\brief Longest path from v in direction Out, memoised in len.
+ *
+ * Every vertex is visited once, so the complexity is O(|E|) for all
+ * vertices together.
+ */
+template<bool Out, typename Graph>
+plength_t longest_path_memo(
+    Graph& g, typename boost::graph_traits<Graph>::vertex_descriptor v,
+    std::vector<plength_t>& len)
+{
+  if (len[v] != unknown_length)
+  {
+    return len[v];
+  }
+  plength_t l_path = 0;
+  if (Out)
+  {
+    BOOST_FOREACH(auto e, out_edges(v, g))
+    {
+      l_path = std::max<plength_t>(
+          l_path, 1 + longest_path_memo<Out>(g, target(e, g), len));
+    }
+  }
+  else
+  {
+    BOOST_FOREACH(auto e, in_edges(v, g))
+    {
+      l_path = std::max<plength_t>(
+          l_path, 1 + longest_path_memo<Out>(g, source(e, g), len));
+    }
+  }
+  return len[v] = l_path;
+}
+
+}  // end namespace detail
+
 /**\ingroup DagInfo
  * \brief Computes the longest directed path (...,v) ending in v.
  *
- * Complexity O(|E|).
+ * Complexity O(|V|+|E|).
  * @tparam Graph Type of the graph.
  * @param[in] g Reference to the graph.
  * @param[in] v Vertex descriptor of the vertex to start from.
@@ -31,26 +78,14 @@ template<typename Graph>
 ADM_STRONG_INLINE plength_t longest_reverse_path_from(
     Graph& g, typename boost::graph_traits<Graph>::vertex_descriptor v)
 {
-  plength_t l_path = 0;
-  plength_t local_l_path = 0;
-
-  if (in_degree(v, g) == 0)
-  {
-    return 0;
-  }
-
-  BOOST_FOREACH(auto e, in_edges(v, g))
-  {
-    local_l_path = longest_reverse_path_from(g, source(e, g));
-    l_path = (local_l_path > l_path) ? local_l_path : l_path;
-  }
-  return 1 + l_path;
+  std::vector<plength_t> len(num_vertices(g), detail::unknown_length);
+  return detail::longest_path_memo<false>(g, v, len);
 }
 
 /**\ingroup DagInfo
  * \brief Computes the longest directed path (v,...) starting with v.
  *
- * Complexity O(|E|).
+ * Complexity O(|V|+|E|).
  * @tparam Graph Type of the graph.
  * @param[in] g Reference to the graph.
  * @param[in] v Vertex descriptor of the vertex to start from.
@@ -60,27 +95,14 @@ template<typename Graph>
 ADM_STRONG_INLINE plength_t longest_path_from(
     Graph& g, typename boost::graph_traits<Graph>::vertex_descriptor v)
 {
-  plength_t l_path = 0;
-  plength_t local_l_path = 0;
-
-  if (out_degree(v, g) == 0)
-  {
-    return 0;
-  }
-
-  BOOST_FOREACH(auto e, out_edges(v, g))
-  {
-    local_l_path = longest_path_from(g, target(e, g));
-    l_path = (local_l_path > l_path) ? local_l_path : l_path;
-  }
-  return 1 + l_path;
+  std::vector<plength_t> len(num_vertices(g), detail::unknown_length);
+  return detail::longest_path_memo<true>(g, v, len);
 }
 
 /**\ingroup DagInfo
  * \brief Computes the longest directed path (...,v,...) including v.
  *
- * Complexity O(|E|).
- * @tparam Graph Type of the graph.
+ * Complexity O(|V|+|E|).
  * @param g Reference to the graph.
  * @param v Vertex descriptor included in the path.
  * @returns Length of the longest path including v.
@@ -96,20 +118,47 @@ ADM_ALWAYS_INLINE plength_t longest_bidirectional_path_from(
  * \brief Computes the length of the longest
  * directed path in a (face) DAG.
  *
- * Complexity O(?).
+ * Dynamic programming over a reverse topological order: sinks have length
+ * 0, and a vertex is processed once all its successors are.
+ *
+ * Complexity O(|V|+|E|).
  * @returns The longest path inside the Graph.
- * @tparam Graph Type of the graph.
+ * @tparam Graph Type of the graph, with vertex descriptors 0,...,|V|-1.
  * @param[in] g Reference to the graph.
  */
 template<typename GraphT>
 ADM_ALWAYS_INLINE plength_t longest_path(GraphT& g)
 {
-  plength_t l_path = 0;
+  const size_t V = num_vertices(g);
+  std::vector<plength_t> len(V, 0);
+  std::vector<size_t> unprocessed(V);
+  std::vector<typename boost::graph_traits<GraphT>::vertex_descriptor> ready;
+  ready.reserve(V);
 
-  for (auto v = vertices(g); v.first != v.second; v.first++)
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    unprocessed[v] = out_degree(v, g);
+    if (unprocessed[v] == 0)
+    {
+      ready.push_back(v);
+    }
+  }
+
+  plength_t l_path = 0;
+  while (!ready.empty())
   {
-    plength_t local_l_path = longest_path_from(g, *v.first);
-    l_path = (local_l_path > l_path) ? local_l_path : l_path;
+    const auto v = ready.back();
+    ready.pop_back();
+    l_path = std::max(l_path, len[v]);
+    BOOST_FOREACH(auto e, in_edges(v, g))
+    {
+      const auto u = source(e, g);
+      len[u] = std::max<plength_t>(len[u], len[v] + 1);
+      if (--unprocessed[u] == 0)
+      {
+        ready.push_back(u);
+      }
+    }
   }
   return l_path;
 }
@@ -35,7 +35,15 @@ void write_graphml(std::ostream& os, admission::DAG& g);
  * @param[inout] os Reference to the ostream to write to.
  * @param[in] g Reference to the DAG.
  */
-void write_graphml(std::ostream& os, admission::FaceDAG& g);
+void write_graphml(std::ostream& os, admission::BoostFaceDAG& g);
+
+/**\brief Writes an admission::FlatFaceDAG
+ * to a file in GRAPHML format by converting it to a BoostFaceDAG.
+ *
+ * @param[inout] os Reference to the ostream to write to.
+ * @param[in] g Reference to the DAG.
+ */
+void write_graphml(std::ostream& os, admission::FlatFaceDAG& g);
 
 }  // end namespace detail
 
@@ -5,14 +5,18 @@
 
 #include "admission_config.hpp"
 #include "graph/DAG.hpp"
+#include "graph/trail.hpp"
 #include "factory.hpp"
 
 #include <boost/foreach.hpp>
+#include <boost/graph/graph_traits.hpp>
 #include <boost/graph/properties.hpp>
 #include <boost/property_map/property_map.hpp>
 
 #include <functional>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 // **************************** Header contents ***************************** //
@@ -20,6 +24,172 @@
 namespace admission
 {
 
+/**\brief We use a struct to encapsule wether we
+ *        want numeric_limits<T>::max()
+ *        or   numeric_limits<T>::min() of a type T.
+ *  @tparam Comp Comparison functor.
+ *  @tprarm T    Type of the functor arguments.
+ */
+template<typename Comp, typename T>
+struct Extreme
+{};
+
+/**\brief Using Extreme<Comp, T> with comp == std::less
+ *        will set value the maximum possible value of T.
+ */
+template<typename T>
+struct Extreme<std::less<>, T>
+{
+  static constexpr T value = std::numeric_limits<T>::max();
+};
+
+/**\brief Using Extreme<Comp, T> with comp == std::greater
+ *        will set value the minumum possible value of T.
+ */
+template<typename T>
+struct Extreme<std::greater<>, T>
+{
+  static constexpr T value = std::numeric_limits<T>::min();
+};
+
+/**\brief Lists the vertices of a (face) DAG in topological order.
+ *
+ * Kahn's algorithm, complexity O(|V|+|E|).
+ * @tparam Graph Type of the (face) DAG, with vertex descriptors 0,...,|V|-1.
+ *
+ * @param[in]  g     A const ref to the (face) DAG.
+ * @param[out] order The vertices of g, every vertex after its predecessors.
+ */
+template<typename Graph>
+void topological_order(
+    const Graph& g,
+    std::vector<typename boost::graph_traits<Graph>::vertex_descriptor>& order)
+{
+  const size_t V = num_vertices(g);
+  order.clear();
+  order.reserve(V);
+  std::vector<size_t> deg(V);
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    deg[v] = in_degree(v, g);
+    if (deg[v] == 0)
+    {
+      order.push_back(v);
+    }
+  }
+  for (size_t p = 0; p < order.size(); ++p)
+  {
+    BOOST_FOREACH(auto oe, out_edges(order[p], g))
+    {
+      if (--deg[target(oe, g)] == 0)
+      {
+        order.push_back(target(oe, g));
+      }
+    }
+  }
+}
+
+/**\brief Yields the extreme edge size within the lower or upper induced
+ *        DAG of a vertex from the values of its neighbours.
+ *
+ * The lower induced DAG of v consists of the out-edges of v and of its
+ * ancestors, the upper one of the in-edges of v and of its descendants.
+ * @tparam Graph    Type of the (face) DAG
+ * @tparam Acc      \ref lower_accessor or \ref upper_accessor -> Are we operating on a lower or upper induced sub-DAG?
+ * @tparam Comp     std::less or std::greater -> are we searching for a min or max value?
+ * @tparam Property Property of the edges we want to compare. Defaults to boost::edge_size_t.
+ *
+ * @param[in] g A const ref to the (face) DAG.
+ * @param[in] v The vertex.
+ * @param[in] f The extreme values of the predecessors (Acc = lower_accessor)
+ *              or successors (Acc = upper_accessor) of v.
+ * @param[in] a Instance of the accessor.
+ * @param[in] c Instance of the comparator.
+ * @param[in] p Instance of the property.
+ * @returns The extreme value for v, Extreme<Comp, flop_t>::value if v
+ *          has no out-edges (in-edges).
+ */
+template<
+    typename Graph, typename Acc = lower_accessor, typename Comp = std::less<>,
+    typename Property = boost::edge_size_t>
+ADM_ALWAYS_INLINE flop_t extreme_at(
+    const Graph& g, typename boost::graph_traits<Graph>::vertex_descriptor v,
+    const std::vector<flop_t>& f, Acc a = lower_accessor(),
+    Comp c = std::less<>(), Property p = boost::edge_size)
+{
+  static_assert(
+      (std::is_same_v<Comp, std::greater<>> ||
+       std::is_same_v<Comp, std::less<>> == true),
+      "Must be used with std::less<> or std::greater<>!");
+  flop_t x = Extreme<Comp, flop_t>::value;
+  if (Acc::reverse::degree(v, g) == 0)
+  {
+    return x;
+  }
+  BOOST_FOREACH(auto e, Acc::reverse::edges(v, g))
+  {
+    if (c(boost::get(p, g, e), x))
+    {
+      x = boost::get(p, g, e);
+    }
+  }
+  BOOST_FOREACH(auto e, Acc::edges(v, g))
+  {
+    if (c(f[a.next_vertex(e, g)], x))
+    {
+      x = f[a.next_vertex(e, g)];
+    }
+  }
+  return x;
+}
+
+/**\brief Helper function for bounds and heuristics that need to search for
+ *        smallest edge-sizes within the upper or lower induced DAGs of all
+ *        vertices.
+ *
+ * Simplified minimal Markowitz
+ * degree bounds use this, as well as the SimpleMinAccCostBound.
+ * A single pass of \ref extreme_at(...) over a topological order,
+ * complexity O(|V|+|E|).
+ * @tparam Graph    Type of the (face) DAG
+ * @tparam Acc      \ref lower_accessor or \ref upper_accessor -> Are we operating on a lower or upper induced sub-DAG?
+ * @tparam Comp     std::less or std::greater -> are we searching for a min or max value?
+ * @tparam Property Property of the edges we want to compare. Defaults to boost::edge_size_t.
+ *
+ * @param[in]  g     A const ref to the (face) DAG.
+ * @param[in]  order The vertices of g as listed by \ref topological_order(...).
+ * @param[out] f     Stores the extreme values for each vertex.
+ * @param[in]  a     Instance of the accessor.
+ * @param[in]  c     Instance of the comparator.
+ * @param[in]  p     Instance of the property.
+ */
+template<
+    typename Graph, typename Acc = lower_accessor, typename Comp = std::less<>,
+    typename Property = boost::edge_size_t>
+void put_extremes(
+    const Graph& g,
+    const std::vector<typename boost::graph_traits<Graph>::vertex_descriptor>&
+        order,
+    std::vector<flop_t>& f, Acc a = lower_accessor(), Comp c = std::less<>(),
+    Property p = boost::edge_size)
+{
+  f.resize(num_vertices(g));
+  if constexpr (std::is_same_v<Acc, lower_accessor>)
+  {
+    for (auto it = order.begin(); it != order.end(); ++it)
+    {
+      f[*it] = extreme_at(g, *it, f, a, c, p);
+    }
+  }
+  else
+  {
+    for (auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+      f[*it] = extreme_at(g, *it, f, a, c, p);
+    }
+  }
+}
+
 /**\brief Base class for lower_bound to be used by branch and bound style algorithms.
  *        Provides a virtual operator() for computing the bound.
  */
@@ -49,84 +219,66 @@ class LowerBound
     return 0;
   }
 
- protected:
-  /**\brief We use a struct to encapsule wether we
-   *        want numeric_limits<T>::max()
-   *        or   numeric_limits<T>::min() of a type T.
-   *  @tparam Comp Comparison functor.
-   *  @tprarm T    Type of the functor arguments.
-   */
-  template<typename Comp, typename T>
-  struct Extreme
-  {};
+  /// Cutoff of a bound whose value is always needed.
+  static constexpr flop_t no_cutoff = std::numeric_limits<flop_t>::max();
 
-  /**\brief Using Extreme<Comp, T> with comp == std::less
-   *        will set value the maximum possible value of T.
+  /**\brief Applies the lower bound to a face DAG whose search is cut
+   *        if the bound is at least cutoff.
+   *
+   * Bounds composed of several steps may stop as soon as cutoff is
+   * reached. Computes the complete bound if it is not overwritten.
+   * @param g Reference to the DAG we compute the bound on.
+   * @param cutoff Smallest value of the bound that cuts the search on g.
+   * @returns A valid lower bound for JA on g, which is complete if it
+   *          is below cutoff.
    */
-  template<typename T>
-  struct Extreme<std::less<>, T>
+  virtual flop_t evaluate(const FaceDAG& g, flop_t) const
   {
-    static constexpr T value = std::numeric_limits<T>::max();
-  };
+    return (*this)(g);
+  }
 
-  /**\brief Using Extreme<Comp, T> with comp == std::greater
-   *        will set value the minumum possible value of T.
+  /**\brief Data of an incremental evaluation of the bound on a face DAG
+   *        that is modified in place, e.g. along a branch of the search.
+   *
+   * Holds the intermediate results of the bound and the scratch buffers
+   * to update them. It is used by a single thread.
    */
-  template<typename T>
-  struct Extreme<std::greater<>, T>
+  class State
   {
-    static constexpr T value = std::numeric_limits<T>::min();
+   public:
+    virtual ~State() {}
   };
 
-  /**\brief Helper function for derived classes that need to search for smallest
-   *        edge-sizes within the upper or lower induced DAGs of an edge.
+  /**\brief Starts an incremental evaluation of the bound on g.
    *
-   * Simplified minimal Markowitz
-   * degree bounds use this, as well as the SimpleMinAccCostBound.
-   * Recursively calls itself on the neighbors of e.
-   * @tparam Graph    Type of the (face) DAG
-   * @tparam EdgeDesc Type of the EdgeDesc of an edge e in g
-   * @tparam Acc      \ref lower_accessor or \ref upper_accessor -> Are we operating on a lower or upper induced sub-DAG?
-   * @tparam Comp     std::less or std::greater -> are we searching for a min or max value?
-   * @tparam Property Property of the edges we want to compare. Defaults to boost::edge_size_t.
-   *
-   * @param[in] g    A const ref to the (face) DAG.
-   * @param[in] e    The EdgeDesc of the edge that induces the sub-DAG.
-   * @param[inout] v Stores the extreme values for each vertex in the induced sub-DAG.
-   * @param[in] a    Instance of the accessor.
-   * @param[in] c    Instance of the comparator.
-   * @param[in] p    Instance of the property.
+   * @param g Reference to the DAG that is going to be modified.
+   * @returns The State of the bound on g, or nullptr if the bound
+   *          has no incremental mode.
    */
-  template<
-      typename Graph, typename EdgeDesc, typename Acc = lower_accessor,
-      typename Comp = std::less<>, typename Property = boost::edge_size_t>
-  void put_extreme(
-      const Graph& g, const EdgeDesc& s, std::vector<flop_t>& v,
-      Acc a = lower_accessor(), Comp c = std::less<>(),
-      Property p = boost::edge_size) const
+  virtual std::unique_ptr<State> make_state(const FaceDAG&) const
   {
-    static_assert(
-        (std::is_same_v<Comp, std::greater<>> ||
-         std::is_same_v<Comp, std::less<>> == true),
-        "Must be used with std::less<> or std::greater<>!");
-    auto m = boost::make_iterator_property_map(
-        v.begin(), boost::get(boost::vertex_index, g));
-
-    if (c(m[a.next_vertex(s, g)], Extreme<Comp, flop_t>::value))
-    {
-      return;
-    }
-
-    m[a.next_vertex(s, g)] = boost::get(p, g, s);
+    return nullptr;
+  }
 
-    BOOST_FOREACH(auto ie, a.next_edges(s, g))
-    {
-      put_extreme(g, ie, v, a, c);
-      if (c(m[a.next_vertex(ie, g)], m[a.next_vertex(s, g)]))
-      {
-        m[a.next_vertex(s, g)] = m[a.next_vertex(ie, g)];
-      }
-    }
+  /**\brief Derives the bound on g after a modification from the bound
+   *        before it.
+   *
+   * The vertices touched by the modification are those reported by
+   * Trail::touched(...). This also works if the modification was rolled
+   * back, with the vertices touched before.
+   * Recomputes the bound if it has no incremental mode.
+   * @param s State returned by make_state(...) for g before the modification.
+   * @param g Reference to the modified DAG.
+   * @param touched The touched vertices, possibly repeated.
+   * @param cutoff Smallest value of the bound that cuts the search on g,
+   *               see evaluate(...). A cutoff of 0 only keeps s up to date.
+   * @returns The bound on g, which is complete if it is below cutoff.
+   */
+  virtual flop_t update(
+      State&, const FaceDAG& g, const TouchedVertices&,
+      flop_t = no_cutoff) const
+  {
+    return (*this)(g);
   }
 };
 
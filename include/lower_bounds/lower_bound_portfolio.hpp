@@ -0,0 +1,146 @@
+#ifndef LOWER_BOUND_PORTFOLIO_HPP
+#define LOWER_BOUND_PORTFOLIO_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "lower_bounds/lower_bound.hpp"
+#include "factory.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Combines several lower bounds into their maximum.
+ *
+ * The bounds are evaluated from the cheapest to the most expensive, by
+ * their mean runtime so far, until one of them reaches the cutoff of
+ * the search. Bounds that have been evaluated a number of times without
+ * ever cutting the search on their own are dropped, as long as another
+ * bound is left.
+ */
+class LowerBoundPortfolio : public LowerBound
+{
+ public:
+  /// Make base class name available.
+  typedef LowerBound Base;
+  /// Transitive propagation of the base class.
+  typedef typename Base::AbstractBase AbstractBase;
+
+  ///\name Constructors and Destructor.
+  ///@{
+  LowerBoundPortfolio() = default;
+
+  ~LowerBoundPortfolio() {}
+
+  ///@}
+
+  /**\brief Adds a bound to the portfolio.
+   *
+   * @param b Pointer to the bound. The portfolio takes ownership.
+   */
+  void add(LowerBound* b);
+
+  /// Number of bounds in the portfolio.
+  size_t size() const
+  {
+    return _members.size();
+  }
+
+  /**\brief Sets after how many evaluations a bound that has not cut
+   *        the search yet is dropped.
+   *
+   * @param n Number of evaluations, 0 keeps all bounds.
+   */
+  void set_drop_after(size_t n)
+  {
+    _drop_after = n;
+  }
+
+  /**\brief Applies all bounds to a face DAG.
+   *
+   * @param g Reference to the DAG we compute the bound on.
+   * @returns The largest of the bounds of the portfolio, 0 if it is empty.
+   */
+  virtual flop_t operator()(const FaceDAG& g) const final;
+
+  /**\brief Applies the bounds to a face DAG until one reaches cutoff.
+   *
+   * @param g Reference to the DAG we compute the bound on.
+   * @param cutoff Smallest value of the bound that cuts the search on g.
+   * @returns The largest of the evaluated bounds.
+   */
+  virtual flop_t evaluate(const FaceDAG& g, flop_t cutoff) const final;
+
+  /**\brief Starts an incremental evaluation of all bounds on g.
+   *
+   * @param g Reference to the DAG that is going to be modified.
+   * @returns The states of the bounds that support it.
+   */
+  virtual std::unique_ptr<State> make_state(const FaceDAG& g) const final;
+
+  /**\brief Derives the bounds on g after a modification until one
+   *        reaches cutoff.
+   *
+   * The states of bounds that are not evaluated collect the touched
+   * vertices until they are.
+   * @param s State returned by make_state(...).
+   * @param g Reference to the modified DAG.
+   * @param touched The touched vertices, possibly repeated.
+   * @param cutoff Smallest value of the bound that cuts the search on g.
+   * @returns The largest of the evaluated bounds.
+   */
+  virtual flop_t update(
+      State& s, const FaceDAG& g, const TouchedVertices& touched,
+      flop_t cutoff = no_cutoff) const final;
+
+  /**\brief Writes the number of evaluations, cuts and the runtime
+   *        of every bound.
+   *
+   * @param[inout] os ostream to write to.
+   */
+  void write(std::ostream& os = std::cout) const;
+
+ private:
+  /// A bound of the portfolio and how much it paid off so far.
+  struct Member
+  {
+    std::unique_ptr<LowerBound> bound;
+    mutable std::atomic<size_t> calls{0};
+    mutable std::atomic<size_t> cuts{0};
+    mutable std::atomic<uint64_t> time_ns{0};
+    mutable std::atomic<bool> active{true};
+  };
+
+  /**\brief Evaluates the active bounds in order of their mean runtime
+   *        until one of them reaches cutoff.
+   *
+   * @param cutoff Smallest value of the bound that cuts the search.
+   * @param eval Callable that yields the value of the i-th bound.
+   * @returns The largest of the evaluated bounds.
+   */
+  template<typename Eval>
+  flop_t run(flop_t cutoff, Eval&& eval) const;
+
+  /// Drops m if it has been evaluated _drop_after times without a cut.
+  void drop_if_unpaid(Member& m) const;
+
+  std::vector<std::unique_ptr<Member>> _members;
+  mutable std::atomic<size_t> _n_active{0};
+  size_t _drop_after = 1000;
+};
+
+ADM_REGISTER_TYPE(LowerBoundPortfolio, LowerBoundPortfolio);
+
+}  // end namespace admission
+
+#endif  // LOWER_BOUND_PORTFOLIO_HPP
@@ -0,0 +1,59 @@
+#ifndef MIN_MUL_COST_BOUND_HPP
+#define MIN_MUL_COST_BOUND_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "lower_bounds/lower_bound.hpp"
+#include "factory.hpp"
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Computes a lower bound for JA by matrix products only, i.e.
+ *        on a face DAG with preaccumulated Jacobians and no tangent or
+ *        adjoint models (preaccumulate_all 1).
+ *
+ * Every index j that is the middle of an intermediate edge (i,j,k) must be
+ * the middle of at least one elimination, and eliminations only inherit
+ * the edges of existing vertices. Hence, the elimination through j costs
+ * at least \f$n_j\f$ times the smallest size of an in-edge of a source of
+ * an edge with index j or of one of its ancestors, times the smallest
+ * size of an out-edge of a target or one of its descendants.
+ * The bound is the sum of these products over all such j.
+ *
+ * \attention Not a valid bound if tangent or adjoint models are available.
+ */
+class MinMulCostBound : public LowerBound
+{
+ public:
+  /// Make base class name available.
+  typedef LowerBound Base;
+  /// Transitive propagation of the base class.
+  typedef typename Base::AbstractBase AbstractBase;
+
+  ///\name Constructors and Destructor.
+  ///@{
+  MinMulCostBound() = default;
+
+  ~MinMulCostBound() {}
+
+  ///@}
+
+  /**\brief Applies the lower bound to a face DAG.
+   *
+   * Complexity O(|V|+|E|).
+   * @param g Reference to the DAG we compute the bound on.
+   * @returns A valid lower bound for FE by matrix products on g.
+   */
+  virtual flop_t operator()(const FaceDAG& g) const final;
+};
+
+ADM_REGISTER_TYPE(MinMulCostBound, MinMulCostBound);
+
+}  // end namespace admission
+
+#endif  // MIN_MUL_COST_BOUND_HPP
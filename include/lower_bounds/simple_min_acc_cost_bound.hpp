@@ -40,6 +40,30 @@ class SimpleMinAccCostBound : public LowerBound
    * @returns A valid lower bound for matrix-free FE on g.
    */
   virtual flop_t operator()(const FaceDAG& g) const final;
+
+  /**\brief Starts an incremental evaluation of the bound on g.
+   *
+   * Complexity O(|V|+|E|).
+   * @param g Reference to the DAG that is going to be modified.
+   * @returns The per-vertex minima and accumulation costs on g.
+   */
+  virtual std::unique_ptr<State> make_state(const FaceDAG& g) const final;
+
+  /**\brief Derives the bound on g after a modification from the bound
+   *        before it.
+   *
+   * The minimal edge sizes in the induced sub-DAGs are only recomputed
+   * for the touched vertices and, as long as they change, for their
+   * descendants and ancestors respectively.
+   * @param s State returned by make_state(...).
+   * @param g Reference to the modified DAG.
+   * @param touched The touched vertices, possibly repeated.
+   * @param cutoff Ignored, the bound is always complete.
+   * @returns The bound on g.
+   */
+  virtual flop_t update(
+      State& s, const FaceDAG& g, const TouchedVertices& touched,
+      flop_t cutoff = no_cutoff) const final;
 };
 
 ADM_REGISTER_TYPE(SimpleMinAccCostBound, SimpleMinAccCostBound);
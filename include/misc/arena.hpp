@@ -0,0 +1,264 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stddef.h>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Bump allocator for the scratch memory of a search node.
+ *
+ * Memory is handed out from large chunks and given back in bulk, by
+ * releasing everything allocated after a mark. The chunks are kept for
+ * reuse, so a search that releases the memory of every subtree it
+ * completes only allocates from the heap while it grows deeper.
+ * Small blocks that are deallocated before are reused by blocks of the
+ * same size, such as the nodes of a std::set.
+ *
+ * Every thread has its own arena, see local(). It must only be used by
+ * this thread, and memory has to be released in the reverse order of
+ * the marks, as done by an ArenaScope.
+ */
+class Arena
+{
+ public:
+  /// Position in the arena to release to.
+  struct Mark
+  {
+    size_t chunk;
+    size_t used;
+  };
+
+  /// Size of a chunk in bytes, unless a larger block is requested.
+  static constexpr size_t chunk_size = 1 << 16;
+  /// Sizes of the small blocks that are reused are multiples of this.
+  static constexpr size_t small_step = alignof(max_align_t);
+  /// Largest small block.
+  static constexpr size_t small_size = 16 * small_step;
+
+  Arena() = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  ~Arena()
+  {
+    for (const Chunk& c : _chunks)
+    {
+      ::operator delete(c.data);
+    }
+  }
+
+  /// Returns the arena of the calling thread.
+  static Arena& local()
+  {
+    thread_local Arena a;
+    return a;
+  }
+
+  /// Returns the current position, which release(...) returns to.
+  Mark mark() const
+  {
+    return Mark{_current, _used};
+  }
+
+  /// Gives back everything allocated after m.
+  void release(const Mark m)
+  {
+    _current = m.chunk;
+    _used = m.used;
+    std::fill(_free, _free + small_size / small_step, nullptr);
+  }
+
+  /**\brief Allocates a block of memory.
+   *
+   * @param bytes Size of the block.
+   * @param align Alignment of the block, at most alignof(max_align_t).
+   * @returns Pointer to the block, valid until it is released.
+   */
+  void* allocate(size_t bytes, size_t align)
+  {
+    if (bytes <= small_size)
+    {
+      const size_t c = small_class(bytes);
+      if (FreeBlock* b = _free[c])
+      {
+        _free[c] = b->next;
+        return b;
+      }
+      bytes = (c + 1) * small_step;
+      align = small_step;
+    }
+    if (_current < _chunks.size())
+    {
+      const size_t p = (_used + align - 1) & ~(align - 1);
+      if (p + bytes <= _chunks[_current].size)
+      {
+        _used = p + bytes;
+        return _chunks[_current].data + p;
+      }
+    }
+    return next_chunk(bytes);
+  }
+
+  /**\brief Gives back a block if it was the last one allocated or if it
+   *        is small, otherwise it is kept until it is released in bulk.
+   *
+   * @param p Pointer to the block.
+   * @param bytes Size of the block.
+   */
+  void deallocate(void* p, size_t bytes)
+  {
+    const bool small = bytes <= small_size;
+    if (small)
+    {
+      bytes = (small_class(bytes) + 1) * small_step;
+    }
+    if (_current < _chunks.size() &&
+        static_cast<char*>(p) + bytes == _chunks[_current].data + _used)
+    {
+      _used -= bytes;
+    }
+    else if (small)
+    {
+      const size_t c = small_class(bytes);
+      _free[c] = new (p) FreeBlock{_free[c]};
+    }
+  }
+
+  /// Number of chunks allocated from the heap so far.
+  size_t heap_allocations() const
+  {
+    return _chunks.size();
+  }
+
+ private:
+  struct Chunk
+  {
+    char* data;
+    size_t size;
+  };
+
+  /// A deallocated small block.
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  /// Index of the free list of small blocks of the given size.
+  static size_t small_class(const size_t bytes)
+  {
+    return bytes ? (bytes - 1) / small_step : 0;
+  }
+
+  /// Continues in the next chunk, which is added if it is too small.
+  void* next_chunk(const size_t bytes)
+  {
+    const size_t next = _chunks.empty() ? 0 : _current + 1;
+    if (next == _chunks.size() || _chunks[next].size < bytes)
+    {
+      const size_t size = std::max(chunk_size, bytes);
+      _chunks.insert(
+          _chunks.begin() + next,
+          Chunk{static_cast<char*>(::operator new(size)), size});
+    }
+    _current = next;
+    _used = bytes;
+    return _chunks[_current].data;
+  }
+
+  std::vector<Chunk> _chunks;
+  size_t _current = 0;
+  size_t _used = 0;
+  /// Deallocated small blocks by size, valid until the next release.
+  FreeBlock* _free[small_size / small_step] = {};
+};
+
+/**\brief Releases the memory allocated from an arena during its lifetime.
+ *
+ * Containers using the arena have to be destroyed before the scope.
+ */
+class ArenaScope
+{
+ public:
+  explicit ArenaScope(Arena& a = Arena::local()) : _arena(a), _mark(a.mark())
+  {}
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  ~ArenaScope()
+  {
+    _arena.release(_mark);
+  }
+
+ private:
+  Arena& _arena;
+  const Arena::Mark _mark;
+};
+
+/**\brief Standard allocator taking memory from an Arena.
+ *
+ * Defaults to the arena of the constructing thread.
+ * @tparam T Type of the allocated objects.
+ */
+template<typename T>
+class ArenaAllocator
+{
+ public:
+  typedef T value_type;
+
+  ArenaAllocator() noexcept : _arena(&Arena::local()) {}
+
+  explicit ArenaAllocator(Arena& a) noexcept : _arena(&a) {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& o) noexcept : _arena(o.arena())
+  {}
+
+  T* allocate(const size_t n)
+  {
+    return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, const size_t n) noexcept
+  {
+    _arena->deallocate(p, n * sizeof(T));
+  }
+
+  /// The arena the memory is taken from.
+  Arena* arena() const noexcept
+  {
+    return _arena;
+  }
+
+  template<typename U>
+  bool operator==(const ArenaAllocator<U>& o) const noexcept
+  {
+    return _arena == o.arena();
+  }
+
+  template<typename U>
+  bool operator!=(const ArenaAllocator<U>& o) const noexcept
+  {
+    return _arena != o.arena();
+  }
+
+ private:
+  Arena* _arena;
+};
+
+/// A std::vector taking its memory from the arena of the constructing thread.
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // end namespace admission
+
+#endif  // ARENA_HPP
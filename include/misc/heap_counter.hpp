@@ -0,0 +1,22 @@
+#ifndef HEAP_COUNTER_HPP
+#define HEAP_COUNTER_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Number of calls of the global operator new so far, by all threads.
+ *
+ * Only counted if ADMission is configured with ADM_COUNT_ALLOCATIONS,
+ * which replaces the global operator new. Always 0 otherwise.
+ */
+count_t heap_allocations();
+
+}  // end namespace admission
+
+#endif  // HEAP_COUNTER_HPP
@@ -0,0 +1,30 @@
+#ifndef MIX_HPP
+#define MIX_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+
+#include <stdint.h>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Finalizer of splitmix64, scrambles the bits of x.
+ *
+ * A bijection on 64 bit integers, so distinct inputs stay distinct.
+ * Shared by the fingerprints of face DAGs, neighbour sets and checkpoints.
+ */
+ADM_ALWAYS_INLINE uint64_t mix(uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+}  // end namespace admission
+
+#endif  // MIX_HPP
@@ -0,0 +1,102 @@
+#ifndef PERIODIC_THREAD_HPP
+#define PERIODIC_THREAD_HPP
+
+// ******************************** Includes ******************************** //
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Background thread calling a function at a fixed interval.
+ *
+ * The function runs once per interval while the thread is running
+ * and, unless told otherwise, a last time on stop(), so the final
+ * state is never missed.
+ * It is never called concurrently with itself. It runs without holding
+ * the lock of the thread, and a long running function may poll
+ * stopping() to return early, so stop(...) does not wait for it.
+ */
+class PeriodicThread
+{
+ public:
+  PeriodicThread() = default;
+  PeriodicThread(const PeriodicThread&) = delete;
+  PeriodicThread& operator=(const PeriodicThread&) = delete;
+
+  /// Stops the thread.
+  ~PeriodicThread()
+  {
+    stop();
+  }
+
+  /**\brief Starts calling f every interval seconds.
+   *
+   * @param[in] interval Time between two calls in seconds.
+   * @param[in] f The function to call.
+   */
+  void start(const double interval, std::function<void()> f)
+  {
+    stop();
+    _f = std::move(f);
+    _stop = false;
+    _thread = std::thread(
+        [this, interval]()
+        {
+          const auto dt = std::chrono::duration<double>(interval);
+          std::unique_lock<std::mutex> lock(_m);
+          while (!_cv.wait_for(lock, dt, [this]() { return _stop.load(); }))
+          {
+            lock.unlock();
+            _f();
+            lock.lock();
+          }
+        });
+  }
+
+  /// True once stop(...) was called, also during the last call.
+  bool stopping() const
+  {
+    return _stop.load();
+  }
+
+  /**\brief Stops the thread.
+   *
+   * @param[in] last Call the function a last time after stopping.
+   */
+  void stop(const bool last = true)
+  {
+    if (!_thread.joinable())
+    {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_m);
+      _stop = true;
+    }
+    _cv.notify_one();
+    _thread.join();
+    if (last)
+    {
+      _f();
+    }
+  }
+
+ private:
+  std::function<void()> _f;
+  std::thread _thread;
+  std::mutex _m;
+  std::condition_variable _cv;
+  std::atomic<bool> _stop{false};
+};
+
+}  // end namespace admission
+
+#endif  // PERIODIC_THREAD_HPP
@@ -0,0 +1,30 @@
+#ifndef THREAD_SLOT_HPP
+#define THREAD_SLOT_HPP
+
+// ******************************** Includes ******************************** //
+
+#include <atomic>
+#include <stddef.h>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**\brief Returns a number identifying the calling thread.
+ *
+ * Threads are numbered from 0 in the order they first call this, so
+ * the number stays the same across OpenMP teams and std::threads.
+ * Containers with a shard per thread index their shards by it.
+ */
+inline size_t thread_slot()
+{
+  static std::atomic<size_t> next{0};
+  thread_local const size_t slot =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+}  // end namespace admission
+
+#endif  // THREAD_SLOT_HPP
@@ -140,6 +140,17 @@ OpSequence cheapest_preacc(const VertexDesc ij, const FaceDAG& g)
   return {make_acc_op(ij, g, acc_c, dir)};
 }
 
+/**\brief Returns the cheapest preaccumulation of an unaccumulated vertex
+ *        if it has a merge candidate and merging is cheaper than
+ *        propagating its neighbouring Jacobians through it.
+ *
+ * @param ij VertexDesc of the vertex to be accumulated.
+ * @param g  Const refrence to the DAG.
+ * @returns OpSequence containing a single AccOp, or OpSequence::make_max()
+ *          if ij should not be merged.
+ */
+OpSequence get_mergeable_preacc(const VertexDesc ij, const FaceDAG& g);
+
 std::pair<OpSequence, VertexDesc> get_mergeable_vertex_on_any_graph(
     const admission::FaceDAG& g);
 
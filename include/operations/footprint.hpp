@@ -0,0 +1,78 @@
+#ifndef FOOTPRINT_HPP
+#define FOOTPRINT_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "graph/trail.hpp"
+#include "operations/op_sequence.hpp"
+
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup OpSequence
+ * @{
+ */
+
+/**\brief The vertices an OpSequence reads and the vertices it modifies,
+ * both as sorted sets.
+ *
+ * Every modified vertex is also read.
+ */
+struct Footprint
+{
+  /// Vertices whose edges or properties the operations look at.
+  std::vector<VertexDesc> reads;
+  /// Vertices that get an edge added or removed or their properties changed.
+  std::vector<VertexDesc> writes;
+};
+
+/**\brief Collects the vertices an OpSequence reads and modifies on g.
+ *
+ * An operation on the vertices X, i.e. X = {ij} for an accumulation
+ * and X = {ij, jk} for an elimination, reads the edges and properties of
+ * at most \f$X \cup S(X) \cup P(S(X))\f$ and the modified vertices.
+ * P(S(X)) holds the vertices fill-in may be absorbed into and the merge
+ * candidates. P(X) is only looked at as a set of vertices.
+ * The modified vertices are exact: s is applied to g with trail and
+ * rolled back again. Vertices created by s are left out, they are
+ * only connected to vertices s modifies.
+ *
+ * Operations that do not read what the other one modifies are independent:
+ * they can be applied in either order with the same result and cost, and
+ * applying one does not change the other.
+ *
+ * \attention Only defined for sequences of AccOp and EliOp, not for their
+ * lazy versions.
+ * @param[in] s The operations.
+ * @param[inout] g The face DAG s is applicable to, unchanged on return.
+ * @param[inout] trail Trail to record the operations in, unchanged on return.
+ * @returns The footprint of s.
+ */
+Footprint footprint(const OpSequence& s, FaceDAG& g, Trail& trail);
+
+/// True if neither footprint modifies a vertex the other one reads.
+bool independent(const Footprint& a, const Footprint& b);
+
+/**\brief Checks if two OpSequences consist of the same operations
+ * on the same vertices.
+ *
+ * @param[in] a OpSequence.
+ * @param[in] b OpSequence.
+ * @returns true if a and b are identical operations.
+ */
+bool same_operations(const OpSequence& a, const OpSequence& b);
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // FOOTPRINT_HPP
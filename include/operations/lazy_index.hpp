@@ -0,0 +1,86 @@
+#ifndef LAZY_INDEX_HPP
+#define LAZY_INDEX_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "graph/trail.hpp"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup OpSequence
+ * @{
+ */
+
+/**\brief Lookup table from index pairs \f$(i,j)\f$ to the intermediate
+ *        vertices of a face DAG, used to apply lazy operations.
+ *
+ * A lazy operation only knows the indices of the vertex or edge it applies
+ * to. Without the index, it has to scan all vertices or edges of the face
+ * DAG. The edge \f$(i,j,k)\f$ is an out-edge of a vertex \f$(i,j)\f$, so
+ * the same table serves accumulations and eliminations.
+ *
+ * The index pair of a vertex does not change while it is intermediate, so
+ * only the vertices touched by an operation have to be added by
+ * update(...). Entries of vertices that are not intermediate anymore are
+ * dropped when their bucket is looked up.
+ */
+class LazyIndex
+{
+ public:
+  /// Indexes the intermediate vertices of g. Complexity O(|V|).
+  explicit LazyIndex(const FaceDAG& g);
+
+  /**\brief Returns the intermediate vertices of g with index pair (i, j).
+   *
+   * Complexity amortised O(1) plus the size of the bucket.
+   * @param[in] i First index.
+   * @param[in] j Second index.
+   * @param[in] g The face DAG.
+   * @returns The vertices in ascending order.
+   */
+  const std::vector<VertexDesc>& vertices(
+      const index_t i, const index_t j, const FaceDAG& g);
+
+  /**\brief Adds the vertices touched by the modifications of g recorded
+   *        in trail after m.
+   *
+   * @param[in] g The modified face DAG.
+   * @param[in] trail The Trail the modifications were recorded in.
+   * @param[in] m Mark before the modifications.
+   */
+  void update(const FaceDAG& g, const Trail& trail, const Trail::Mark m);
+
+ private:
+  /// Adds v if it is intermediate.
+  void add(const VertexDesc v, const FaceDAG& g);
+
+  /// Key of the index pair (i, j).
+  static uint64_t key(const index_t i, const index_t j)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(i)) << 32) |
+           static_cast<uint32_t>(j);
+  }
+
+  std::unordered_map<uint64_t, std::vector<VertexDesc>> _buckets;
+
+  /// Returned for index pairs without vertices.
+  const std::vector<VertexDesc> _none;
+};
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // LAZY_INDEX_HPP
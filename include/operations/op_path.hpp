@@ -0,0 +1,126 @@
+#ifndef OP_PATH_HPP
+#define OP_PATH_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "operations/op_sequence.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup OpSequence
+ * @{
+ */
+
+/**\brief Persistent sequence of operations, the path from the root of a
+ *        search tree to one of its nodes.
+ *
+ * An OpPath is an immutable list of segments linked to their parents.
+ * Appending a segment creates a single new node that shares the whole
+ * prefix with the original path, so the children of a search node all
+ * share the path to it instead of copying it. The nodes are reference
+ * counted and freed with the last path that contains them.
+ *
+ * Cost and size are stored per node, so they are queried in O(1).
+ * sequence() materialises the path into an OpSequence, which is only
+ * required when a solution is reported or written.
+ */
+class OpPath
+{
+ public:
+  /// The empty path with a cost of 0.
+  OpPath() = default;
+
+  /// A path consisting of the single segment s.
+  explicit OpPath(OpSequence s) : OpPath(OpPath(), std::move(s)) {}
+
+  /**\brief Returns this path followed by s. This path is not changed.
+   *
+   * Complexity O(|s|), independent of the length of this path.
+   * @param[in] s The operations to append.
+   * @returns The longer path.
+   */
+  ADM_ALWAYS_INLINE
+  OpPath operator+(OpSequence s) const
+  {
+    return OpPath(*this, std::move(s));
+  }
+
+  /// Returns the cost of the whole path.
+  ADM_ALWAYS_INLINE
+  flop_t cost() const
+  {
+    return _tail ? _tail->cost : 0;
+  }
+
+  /// Returns the number of operations on the whole path.
+  ADM_ALWAYS_INLINE
+  size_t size() const
+  {
+    return _tail ? _tail->size : 0;
+  }
+
+  /// Returns true if the path contains no operations.
+  ADM_ALWAYS_INLINE
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  /**\brief Materialises the path.
+   *
+   * @returns All operations from the root on as a single OpSequence.
+   */
+  OpSequence sequence() const
+  {
+    std::vector<const Node*> nodes;
+    for (const Node* n = _tail.get(); n != nullptr; n = n->parent.get())
+    {
+      nodes.push_back(n);
+    }
+    OpSequence res = OpSequence::make_empty();
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+    {
+      res += (*it)->ops;
+    }
+    return res;
+  }
+
+ private:
+  /// A segment of the path and the accumulated cost and size up to it.
+  struct Node
+  {
+    std::shared_ptr<const Node> parent;
+    OpSequence ops;
+    flop_t cost;
+    size_t size;
+  };
+
+  OpPath(const OpPath& prefix, OpSequence s)
+  {
+    const flop_t cost = prefix.cost() + s.cost();
+    const size_t size = prefix.size() + static_cast<size_t>(s.size());
+    _tail = std::make_shared<const Node>(
+        Node{prefix._tail, std::move(s), cost, size});
+  }
+
+  /// Last segment of the path, nullptr for the empty path.
+  std::shared_ptr<const Node> _tail;
+};
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // OP_PATH_HPP
@@ -6,10 +6,14 @@
 #include "admission_config.hpp"
 #include "graph/DAG.hpp"
 
+#include <boost/container/small_vector.hpp>
+
 #include <initializer_list>
+#include <iterator>
 #include <istream>
 #include <limits>
-#include <list>
+#include <stdexcept>
+#include <stdint.h>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -18,7 +22,8 @@
 
 namespace admission
 {
-class Op;
+class LazyIndex;
+class Trail;
 }
 
 // **************************** Header contents ***************************** //
@@ -56,7 +61,8 @@ const std::string dir_to_s(dir_t o)
     }
     default:
     {
-      throw;
+      throw std::runtime_error(
+          "Unknown direction " + std::to_string(static_cast<int>(o)) + "!");
     }
   }
 }
@@ -65,6 +71,7 @@ const std::string dir_to_s(dir_t o)
  *
  *  @param s identifier string.
  *  @returns The corresponding enum value.
+ *  @throws std::runtime_error if s is none of MUL, TAN and ADJ.
  */
 ADM_ALWAYS_INLINE
 dir_t s_to_dir(std::string s)
@@ -83,192 +90,68 @@ dir_t s_to_dir(std::string s)
   }
   else
   {
-    throw;
+    throw std::runtime_error(
+        "Direction \"" + s + "\" is neither \"MUL\", \"TAN\" nor \"ADJ\"!");
   }
 }
 
+/** \enum op_kind_t
+ *  \brief Kinds of operations an OpCont can hold.
+ */
+enum op_kind_t : unsigned char
+{
+  /// Accumulation of the vertex _ij.
+  ACC_OP,
+  /// Elimination of the edge (_ij, _jk).
+  ELI_OP,
+  /// Accumulation of the vertex with the indices (_i, _j).
+  LAZY_ACC_OP,
+  /// Elimination of the edge with the indices (_i, _j, _k).
+  LAZY_ELI_OP
+};
+
 /**
- * \brief Container for data members for accumulations and eliminations.
+ * \brief Compact container for accumulations and eliminations.
  *
- * We do this to have uniform data for AccOp and EliOp to store them in Arrays.
- * Declares essential apply functions that are forwarded to Op.
+ * We do this to have uniform data for all kinds of operations to store them
+ * in arrays. An edge is stored by its source and target vertex, which are
+ * stable during the search, and the kind of operation selects the
+ * implementation of apply(), write() and where() in a switch.
  */
 struct OpCont
 {
-  /// Store a VertexDesc in case OpCont holds an AccOp.
-  VertexDesc _ij;
-  /// Store an EdgeDesc in case OpCont holds an EliOp.
-  EdgeDesc _ijk;
-  /// Store the indices in case OpCont holds a LazyEli/AccOp.
+  /// VertexDesc of an accumulated vertex or of the source of an edge.
+  uint32_t _ij;
+  /// VertexDesc of the target of an eliminated edge.
+  uint32_t _jk;
+  /// Store the indices to print the operation and for lazy operations.
   index_t _i, _j, _k;
-  /// Cost of the opaeration in terms of FMA.
+  /// TAN, ADJ or MUL.
+  dir_t _dir : 8;
+  /// What the OpCont holds.
+  op_kind_t _kind : 8;
+  /// Cost of the operation in terms of FMA.
   flop_t _cost;
-  /// TAN or ADJ.
-  dir_t _dir;
-  /// Pointer to static (Lazy)Acc/EliOp to delegate function calls.
-  Op* _functions;
 
-  /// Delegate printing.
+  /// Write this operation to a stream.
   std::ostream& write(std::ostream& o) const;
-  /// Delegate applycation to a face DAG.
-  bool apply(FaceDAG& g) const;
-  /// Delegate printing of the index pair or triple.
+  /// Apply this operation to a face DAG, recording it in a Trail if given.
+  /// Lazy operations look up their vertices in index if given.
+  bool apply(
+      FaceDAG& g, Trail* trail = nullptr, LazyIndex* index = nullptr) const;
+  /// Print the index pair or triple.
   const std::string where() const;
 };
 
-class Op
-{
- public:
-  /**\brief Write this operation to a stream.
-   */
-  virtual std::ostream& write(std::ostream&, const OpCont*) const = 0;
-
-  /**\brief Apply the Operation to a FaceDAG with certain properties for the EliminationAlgorithm.
-   */
-  virtual bool apply(FaceDAG&, const OpCont*) const = 0;
-
-  /**\brief Return the descriptor of the edge or vertex respectively as a string.
-   */
-  virtual const std::string where(const OpCont*) const = 0;
-};
-
-/**
- * \brief Accumulation Operation, derives from Op.
- *
- * Implements the application and i/o functions.
- */
-class AccOp : public Op
-{
- public:
-  /**\brief Write info about this AccOp to a stream.
-   *
-   * @param[inout] o Reference to a std::ostream.
-   * @param [in]  opc Pointer to the container.
-   */
-  virtual std::ostream& write(
-      std::ostream& o, const OpCont* opc) const override final;
-
-  /**\brief Apply this AccOp to a FaceDAG.
-   *
-   * @param [inout] g Reference to the FaceDAG.
-   * @param [in]  opc Pointer to the container.
-   * @returns bool true if successful.
-   */
-  virtual bool apply(FaceDAG& g, const OpCont* opc) const override;
-
-  /**\brief Stringify the index pair _where.
-   *
-   * @param [in]  opc Pointer to the container.
-   * @returns std::string "i, j"
-   */
-  virtual const std::string where(const OpCont* opc) const override;
-};
-
-/**\brief Lazy Accumulation Op that needs to search for
- *        the correct vertex before application.
- *
- *        Used when reading Ops from a stream.
- *        Derives its i/o functionsfrom AccOp.
- */
-class LazyAccOp : public AccOp
-{
- public:
-  /**\brief Apply this AccOp to a FaceDAG.
-   *
-   * @param [inout] g Reference to the FaceDAG.
-   * @param [in]  opc Pointer to the container.
-   * @returns bool true if successful.
-   */
-  virtual bool apply(FaceDAG& g, const OpCont* opc) const override;
-};
-
-/**\brief Elimination Operation.
- *
- * Implements the application and i/o functions for
- * eliminations. Derives from Op.
- */
-class EliOp : public Op
-{
- public:
-  /**\brief Write info about this AccOp to a stream.
-   *
-   * @param[inout] o Reference to a std::ostream.
-   * @param [in]  opc Pointer to the container.
-   * @returns std::ostream& o.
-   */
-  virtual std::ostream& write(
-      std::ostream& o, const OpCont* opc) const override final;
-
-  /**\brief Apply this EliOp to a FaceDAG.
-   *
-   * @param [inout] g Reference to the FaceDAG.
-   * @param [in]  opc Pointer to the container.
-   * @returns bool true if successful.
-   */
-  virtual bool apply(FaceDAG& g, const OpCont* opc) const override;
+static_assert(sizeof(OpCont) <= 32, "OpCont should fit in half a cache line.");
 
-  /**\brief Stringify the index triple _where.
-   *
-   * @param [in]  opc Pointer to the container.
-   * @returns std::string (i, j, k)
-   */
-  virtual const std::string where(const OpCont* opc) const override final;
-};
-
-/**\brief Lazy Elimination Operation that searches for the
- *        correct edge before eliminating it.
- *
- *        Inherits its i/o functions from EliOp.
- */
-class LazyEliOp : public EliOp
-{
- public:
-  /**\brief Apply this EliOp to a FaceDAG.
-   *
-   * @param [inout] g Reference to the FaceDAG.
-   * @param [in]  opc Pointer to the container.
-   * @returns bool true if successful.
-   */
-  virtual bool apply(FaceDAG& g, const OpCont* opc) const override;
-};
-
-/** Forward call to write() to the Op. Kept in header for inlining.
- */
-inline std::ostream& OpCont::write(std::ostream& o) const
-{
-  return _functions->write(o, this);
-}
-
-/** Forward call to apply() to the Op. Kept in header for inlining.
- */
-inline bool OpCont::apply(FaceDAG& g) const
-{
-  return _functions->apply(g, this);
-}
-
-/** Forward call to where() to the Op. Kept in header for inlining.
- */
-inline const std::string OpCont::where() const
+/// True if opc holds a (lazy) elimination, false for a (lazy) accumulation.
+ADM_ALWAYS_INLINE
+bool is_elimination(const OpCont& opc)
 {
-  return _functions->where(this);
+  return opc._kind == ELI_OP || opc._kind == LAZY_ELI_OP;
 }
 
-/*
- * We avoid possible overhead
- * if the construction of Op
- * that does not contain data
- * members is not optimized out.
- */
-
-/// Static AccOp to point to in OpCont
-static AccOp acc_op;
-/// Static EliOp to point to in OpCont
-static EliOp eli_op;
-/// Static LazyAccOp to point to in OpCont
-static LazyAccOp lazy_acc_op;
-/// Static LazyEliOp to point to in OpCont
-static LazyEliOp lazy_eli_op;
-
 /**\brief External make function for accumulation operation.
  *        Convenient because of the explicit name.
  *
@@ -278,16 +161,18 @@ static LazyEliOp lazy_eli_op;
  * @param[in] g const & to the FaceDAG.
  * @param[in] c cost of the accumulation to be stored.
  * @param[in] d direction TAN or ADJ.
- * @returns OpCont whose _functions point to acc_op.
+ * @returns OpCont of kind ACC_OP.
  */
 inline OpCont make_acc_op(VertexDesc v, const FaceDAG& g, flop_t c, dir_t d)
 {
   OpCont opc;
-  opc._ij = v;
+  opc._ij = static_cast<uint32_t>(v);
+  opc._jk = 0;
   std::tie(opc._i, opc._j) = index_pair(v, g);
+  opc._k = 0;
   opc._cost = c;
   opc._dir = d;
-  opc._functions = &acc_op;
+  opc._kind = ACC_OP;
   return opc;
 }
 
@@ -296,23 +181,24 @@ inline OpCont make_acc_op(VertexDesc v, const FaceDAG& g, flop_t c, dir_t d)
  *
  * We could also do this as a constructor of OpCont,
  * but would have a more implicit syntax.
- * This version leaves _ij uninitilised and sets _functions
- * to lazy_acc_op.
+ * This version does not store a vertex and creates a LAZY_ACC_OP.
  * @param[in] i First index of the vertex ij.
  * @param[in] j Second index of the vertex ij.
  * @param[in] g const & to the FaceDAG.
  * @param[in] c cost of the accumulation to be stored.
  * @param[in] d direction TAN or ADJ.
- * @returns OpCont whose _functions point to acc_op.
+ * @returns OpCont of kind LAZY_ACC_OP.
  */
 inline OpCont make_acc_op(index_t i, index_t j, flop_t c, dir_t d)
 {
   OpCont opc;
+  opc._ij = opc._jk = 0;
   opc._i = i;
   opc._j = j;
+  opc._k = 0;
   opc._dir = d;
   opc._cost = c;
-  opc._functions = &lazy_acc_op;
+  opc._kind = LAZY_ACC_OP;
   return opc;
 }
 
@@ -325,16 +211,17 @@ inline OpCont make_acc_op(index_t i, index_t j, flop_t c, dir_t d)
  * @param[in] g const & to the FaceDAG.
  * @param[in] c cost of the accumulation to be stored.
  * @param[in] d direction TAN or ADJ.
- * @returns OpCont whose _functions point to acc_op.
+ * @returns OpCont of kind ELI_OP.
  */
 inline OpCont make_eli_op(EdgeDesc e, const FaceDAG& g, flop_t c, dir_t d)
 {
   OpCont opc;
-  opc._ijk = e;
+  opc._ij = static_cast<uint32_t>(source(e, g));
+  opc._jk = static_cast<uint32_t>(target(e, g));
   std::tie(opc._i, opc._j, opc._k) = index_triple(e, g);
   opc._dir = d;
   opc._cost = c;
-  opc._functions = &eli_op;
+  opc._kind = ELI_OP;
   return opc;
 }
 
@@ -343,25 +230,25 @@ inline OpCont make_eli_op(EdgeDesc e, const FaceDAG& g, flop_t c, dir_t d)
  *
  * We could also do this as a constructor of OpCont,
  * but would have a more implicit syntax.
- * This version leaves _ijk uninitilised and sets _functions
- * to lazy_eli_op.
+ * This version does not store an edge and creates a LAZY_ELI_OP.
  * @param[in] i First index of the vertex (i,j,k).
  * @param[in] j Second index of the vertex (i,j,k).
  * @param[in] k Second index of the vertex (i,j,k).
  * @param[in] g const & to the FaceDAG.
  * @param[in] c cost of the accumulation to be stored.
  * @param[in] d direction TAN or ADJ.
- * @returns OpCont whose _functions point to acc_op.
+ * @returns OpCont of kind LAZY_ELI_OP.
  */
 inline OpCont make_eli_op(index_t i, index_t j, index_t k, flop_t c, dir_t d)
 {
   OpCont opc;
+  opc._ij = opc._jk = 0;
   opc._i = i;
   opc._j = j;
   opc._k = k;
   opc._dir = d;
   opc._cost = c;
-  opc._functions = &lazy_eli_op;
+  opc._kind = LAZY_ELI_OP;
   return opc;
 }
 
@@ -369,7 +256,9 @@ inline OpCont make_eli_op(index_t i, index_t j, index_t k, flop_t c, dir_t d)
  *
  * Contains a sequence of eliminations that can be applied to a FaceDAG.
  * Also stores the cost of the eliminations. This essentially wraps around a
- * std::list<Op*> and forwards its iterators etc. Additionally containts functions
+ * small vector of OpCont and forwards its iterators etc. Sequences of up to
+ * two operations, which the optimizers build for every candidate, are
+ * stored inline without allocating. Additionally containts functions
  * to apply all eliminations to a FaceDAG either silent or verbose.
  */
 class OpSequence
@@ -403,7 +292,13 @@ class OpSequence
 
   OpSequence() = delete;
   OpSequence(const OpSequence&) = default;
-  OpSequence(OpSequence&&) = default;
+  /* Swaps instead of moving element-wise. Moving the inline storage of
+   * the small_vector makes GCC warn about a memmove it cannot bound
+   * (-Wstringop-overread), a false positive. */
+  OpSequence(OpSequence&& other) noexcept : _cost(other._cost)
+  {
+    _sequence.swap(other._sequence);
+  }
   OpSequence& operator=(OpSequence&&) = default;
   OpSequence& operator=(const OpSequence&) = default;
   ~OpSequence() = default;
@@ -416,28 +311,28 @@ class OpSequence
    */
   ///@{
 
-  /// Wrap around the begin() function of std::list.
+  /// Wrap around the begin() function of the storage.
   ADM_ALWAYS_INLINE
   auto begin() const
   {
     return _sequence.begin();
   }
 
-  /// Wrap around the   end() function of std::list.
+  /// Wrap around the end() function of the storage.
   ADM_ALWAYS_INLINE
   auto end() const
   {
     return _sequence.end();
   }
 
-  /// Wrap around the front() function of std::list.
+  /// Wrap around the front() function of the storage.
   ADM_ALWAYS_INLINE
   auto& front() const
   {
     return _sequence.front();
   }
 
-  /// Wrap around the  back() function of std::list.
+  /// Wrap around the back() function of the storage.
   ADM_ALWAYS_INLINE
   auto& back() const
   {
@@ -510,10 +405,8 @@ class OpSequence
   OpSequence& operator+=(const OpSequence& other)
   {
     _cost += other._cost;
-    for (auto& ep : other._sequence)
-    {
-      _sequence.emplace_back(ep);
-    }
+    _sequence.insert(
+        _sequence.end(), other._sequence.begin(), other._sequence.end());
     return *this;
   }
 
@@ -527,17 +420,55 @@ class OpSequence
   ADM_ALWAYS_INLINE
   OpSequence& operator+=(OpSequence&& other)
   {
-    // Vector storage.
-    // _sequence.insert(_sequence.end(), other._sequence.begin(), other._sequence.end());
-
-    // List storage.
-    _sequence.splice(_sequence.end(), std::move(other._sequence));
+    if (_sequence.empty())
+    {
+      _sequence = std::move(other._sequence);
+    }
+    else
+    {
+      _sequence.insert(
+          _sequence.end(), std::make_move_iterator(other._sequence.begin()),
+          std::make_move_iterator(other._sequence.end()));
+    }
     _cost += other._cost;
     return *this;
   }
 
-  /// Applies the OpSequence to a FaceDAG.
-  FaceDAG& apply(FaceDAG&) const;
+  /**\brief Removes the operations of prefix from the front of this.
+   *
+   * If a sequence solves a face DAG and starts with prefix, the rest of
+   * it solves the face DAG that applying prefix leads to.
+   * @param[in] prefix The operations to remove.
+   * @returns False and leaves this unchanged if it does not start with
+   *          the operations of prefix.
+   */
+  bool remove_prefix(const OpSequence& prefix);
+
+  /// True if this starts with the operations of prefix.
+  bool starts_with(const OpSequence& prefix) const;
+
+  /// Applies the OpSequence to a FaceDAG, recording it in a Trail if given.
+  FaceDAG& apply(FaceDAG&, Trail* trail = nullptr) const;
+
+  /**\brief Applies the OpSequence to a FaceDAG, looking up the vertices of
+   *        lazy operations in a LazyIndex.
+   *
+   * Replays a sequence of lazy operations, e.g. from read_sequence(...),
+   * in O(|V|) plus the size of the modifications instead of a search of
+   * the whole face DAG per operation.
+   */
+  FaceDAG& indexed_apply(FaceDAG&) const;
+
+  /**\brief Applies the OpSequence to a FaceDAG, looking up the vertices of
+   *        lazy operations, and returns it with the costs on that FaceDAG.
+   *
+   * Validates a sequence read by read_sequence(...), whose costs may stem
+   * from a different DAG, e.g. a previous version of g.
+   * @param[inout] g The FaceDAG to apply the operations to.
+   * @returns The operations on the vertices of g with their costs on g.
+   * @throws std::runtime_error if an operation cannot be applied to g.
+   */
+  OpSequence replay(FaceDAG& g) const;
 
   /// Applies the OpSequence to a FaceDAG and prints intermediate FaceDAG s.
   FaceDAG& verbose_apply(FaceDAG&, std::string path = "") const;
@@ -550,15 +481,13 @@ class OpSequence
   flop_t _cost;
 
   /// All operations.
-  std::list<OpCont> _sequence;
-
-  /// Alternative Storage for the operations.
-  // std::vector<OpCont> _sequence;
+  boost::container::small_vector<OpCont, 2> _sequence;
 };
 
 /** \brief Read an OpSequence using the same syntax as the admissio::read_graph() functions.
  * @param[in]  ist std::istream to read the OpSequence from.
  * @param[out] els OpSequence& to fill.
+ * @throws std::runtime_error if ist holds an unknown or incomplete operation.
  */
 void read_sequence(std::istream&& ist, OpSequence& els);
 
@@ -1,5 +1,6 @@
 // IWYU pragma: begin_exports
 
+#include "optimizers/best_first_optimizer.hpp"
 #include "optimizers/branch_and_bound.hpp"
 #include "optimizers/greedy_optimizer.hpp"
 #include "optimizers/min_edge_fill_in_optimizer.hpp"
@@ -0,0 +1,110 @@
+#ifndef BEST_FIRST_OPTIMIZER_HPP
+#define BEST_FIRST_OPTIMIZER_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "operations/op_sequence.hpp"
+#include "optimizers/branch_and_bound.hpp"
+#include "factory.hpp"
+
+#include <stddef.h>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Optimizers
+ * @{
+ */
+
+/**\brief Best-first (A*) search for an optimal elimination sequence.
+ *
+ * Expands the open node with the smallest cost so far plus lower bound
+ * first, so no node that is more expensive than the optimum is expanded
+ * if the LowerBound is admissible. Instead of face DAGs, the open list
+ * stores for every node the operations leading to it from its parent.
+ * The face DAG of a node is rebuilt from the input when it is expanded.
+ * Face DAGs reached on different paths are detected by their FaceDAGHash
+ * and only kept once.
+ *
+ * If the open list exceeds the memory budget, the remaining open nodes
+ * are searched depth-first by the BranchAndBound, in order of their
+ * bounds, as OpenMP tasks.
+ */
+class BestFirstOptimizer : public BranchAndBound
+{
+ public:
+  /// Make the base class available.
+  typedef BranchAndBound Base;
+  /// Make the transitive base class available.
+  typedef typename Base::AbstractBase AbstractBase;
+
+  ///\name Constructors & Destructors.
+  ///@{
+  BestFirstOptimizer(const LowerBound& lbound) : Base(lbound) {}
+
+  BestFirstOptimizer() = default;
+
+  virtual ~BestFirstOptimizer() override {}
+
+  ///@}
+
+  /**\brief Set the memory of the open list before falling back to
+   * depth-first search.
+   *
+   * @param[in] megabytes Approximate memory cap of the open list.
+   */
+  void set_memory_budget(const size_t megabytes)
+  {
+    _memory_budget = megabytes << 20;
+  }
+
+  /**\brief Override the virtual solve function.
+   *
+   * @param[in] g FaceDAG& The input.
+   * @returns OpSequence The optimal sequence.
+   */
+  virtual OpSequence solve(FaceDAG& g) const override;
+
+ protected:
+  /// A node of the search tree, encoded by the path to it.
+  struct Node
+  {
+    /// Index of the parent node. The root is its own parent.
+    size_t parent;
+    /// The operations leading from the parent to this node.
+    OpSequence ops;
+    /// Cost of the operations leading from the root to this node.
+    flop_t cost;
+    /// Depth of the node in the search tree.
+    flop_t depth;
+  };
+
+  /**\brief Rebuilds the face DAG of a node.
+   *
+   * @param[in] nodes All nodes created so far.
+   * @param[in] n Index of the node.
+   * @param[inout] h Copy of the input, the operations are applied to it.
+   * @returns The operations leading from the root to the node.
+   */
+  static OpSequence rebuild(
+      const std::vector<Node>& nodes, size_t n, FaceDAG& h);
+
+  /// Approximate memory of the open list in bytes.
+  size_t _memory_budget = size_t(1024) << 20;
+};
+
+ADM_REGISTER_TYPE(BestFirstOptimizer, BestFirstOptimizer);
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // BEST_FIRST_OPTIMIZER_HPP
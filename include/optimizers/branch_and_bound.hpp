@@ -5,21 +5,37 @@
 
 #include "admission_config.hpp"
 #include "graph/DAG.hpp"
+#include "lower_bounds/lower_bound.hpp"
+#include "misc/arena.hpp"
+#include "operations/footprint.hpp"
+#include "operations/op_path.hpp"
 #include "operations/op_sequence.hpp"
+#include "optimizers/checkpoint.hpp"
 #include "optimizers/estimator.hpp"
 #include "optimizers/greedy_optimizer.hpp"
+#include "optimizers/heuristic_policy.hpp"
 #include "optimizers/min_fill_in_optimizer.hpp"
 #include "optimizers/optimizer.hpp"
 #include "optimizers/optimizer_stats.hpp"
+#include "optimizers/transposition_table.hpp"
+#include "optimizers/work_stealing.hpp"
 #include "factory.hpp"
 
+#include <atomic>
+#include <functional>
 #include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
 
 // ************************** Forward declarations ************************** //
 
 namespace admission
 {
 class LowerBound;
+class PeriodicThread;
+class SolvedState;
+class Trail;
 }
 
 // **************************** Header contents ***************************** //
@@ -32,6 +48,33 @@ namespace admission
  * @{
  */
 
+/// A branch that is not searched again, with its Footprint.
+struct SleepingBranch
+{
+  OpSequence ops;
+  Footprint fp;
+};
+
+/// Branches a subtree of the BranchAndBound skips.
+typedef std::vector<SleepingBranch> SleepSet;
+
+/// Ways of distributing the search tree of a BranchAndBound to threads.
+enum class BnBMode
+{
+  /// Every branch above the task-spawning depth is an OpenMP task.
+  Tasks,
+  /// Per-thread deques of open nodes, split on demand for idle threads.
+  WorkStealing
+};
+
+/**\brief Converts the name of an execution mode ("tasks" or "work_stealing").
+ *
+ * @param[in] s The name of the mode.
+ * @returns The mode.
+ * @throws std::runtime_error if s does not name a mode.
+ */
+BnBMode to_bnb_mode(const std::string& s);
+
 /**\brief Branch and bound algorithm.
  *
  * Has a reference to a class that computes a lower bound.
@@ -51,13 +94,19 @@ class BranchAndBound : public Optimizer
   BranchAndBound(const LowerBound& lbound)
       : _lbound(&lbound),
         _parallel_depth(1),
-        _glob_opt_s(OpSequence::make_max())
+        _mode(BnBMode::Tasks),
+        _por(false),
+        _glob_opt_c(OpSequence::make_max().cost()),
+        _glob_opt_s(std::make_shared<const OpSequence>(OpSequence::make_max()))
   {}
 
   BranchAndBound()
       : _lbound(nullptr),
         _parallel_depth(1),
-        _glob_opt_s(OpSequence::make_max())
+        _mode(BnBMode::Tasks),
+        _por(false),
+        _glob_opt_c(OpSequence::make_max().cost()),
+        _glob_opt_s(std::make_shared<const OpSequence>(OpSequence::make_max()))
   {}
 
   virtual ~BranchAndBound() override {}
@@ -67,7 +116,7 @@ class BranchAndBound : public Optimizer
   /// Reset the optimal soluton cost and the counters.
   virtual void reset() override
   {
-    _glob_opt_s = OpSequence::make_max();
+    reset_glob_opt();
     Base::reset();
   }
 
@@ -107,6 +156,130 @@ class BranchAndBound : public Optimizer
     return _lbound;
   }
 
+  /**\brief Set up the transposition table that stores the bounds
+   * of face DAGs reached on different paths through the search tree.
+   *
+   * @param[in] megabytes Memory cap of the table. 0 disables it.
+   * @param[in] policy Replacement policy for full buckets.
+   */
+  void set_transposition_table(
+      const size_t megabytes,
+      const TTReplacement policy = TTReplacement::Depth)
+  {
+    _tt.resize(megabytes, policy);
+  }
+
+  /**\brief Select how the search tree is distributed to the threads.
+   *
+   * In BnBMode::WorkStealing, every thread searches its nodes depth-first
+   * in place and splits off untried branches close to the root whenever
+   * another thread runs out of work. The parallel depth is ignored.
+   */
+  void set_execution_mode(const BnBMode m)
+  {
+    _mode = m;
+  }
+
+  /**\brief Enable partial order reduction.
+   *
+   * Operations that do not read what the other one modifies commute, see
+   * footprint(...). With a sleep set per node, every order of independent
+   * operations is searched only once. Skipped branches are counted as
+   * PORSkip.
+   *
+   * Ignored while the transposition table is enabled: it already cuts
+   * the reordered sequences, and nodes with sleeping branches cannot be
+   * stored. With both on, bat_n1_c1 searched eight times more nodes.
+   * Without the table, lion_small_n1 searches 35-51% fewer nodes and
+   * R2 5-7% fewer. On lion_n1_c1 and Nau04Fig1 hardly any operations
+   * are independent and nothing is skipped.
+   */
+  void set_partial_order_reduction(const bool on)
+  {
+    _por = on;
+  }
+
+  /**\brief Sets the number of random probes that estimate the size of
+   * the search tree for the progress output. 0 falls back to the
+   * per-depth estimate of the Estimator.
+   */
+  void set_probes(const size_t n)
+  {
+    _probes = n;
+  }
+
+  /**\brief Sets how often a probe may evaluate the lower bound, see
+   * probe_search_space(...). The probes run on the thread of the progress
+   * output, next to the search threads. 0 does not limit them.
+   */
+  void set_probe_budget(const size_t n)
+  {
+    _probe_budget = n;
+  }
+
+  /**\brief Starts the next search with a global optimum read from a
+   * file written by OpSequence::write(...), e.g. the solution of a
+   * previous version of the face DAG. It is ignored if it does not
+   * solve the face DAG.
+   *
+   * @param[in] p The file to read, nothing is read if empty.
+   */
+  void set_initial_solution(const fs::path& p)
+  {
+    _initial_solution = p;
+  }
+
+  /**\brief Periodically writes the completed subtrees, the global
+   * optimum, the stats and the estimator to a file, see Checkpoint.
+   *
+   * @param[in] p The file to write to, nothing is written if empty.
+   * @param[in] interval Seconds between two checkpoints.
+   * @param[in] depth Deepest subtree tracked.
+   */
+  void set_checkpoint(
+      const fs::path& p, const double interval, const size_t depth)
+  {
+    _checkpoint_path = p;
+    _checkpoint_interval = interval;
+    _checkpoint_depth = depth;
+  }
+
+  /**\brief Resumes the next search from a checkpoint, skipping the
+   * subtrees it completed. The checkpoint is ignored if it was written
+   * for a different face DAG.
+   *
+   * \attention The transposition table is not restored. Transpositions of
+   * completed subtrees reached on open paths are searched again.
+   *
+   * @param[in] p The checkpoint to read, nothing is read if empty.
+   */
+  void set_resume(const fs::path& p)
+  {
+    _resume_path = p;
+  }
+
+  /**\brief The policy deciding at which nodes the greedy heuristics run,
+   * counted as HeurRun, HeurSkip and HeurReuse.
+   */
+  HeuristicPolicy& heuristic_policy()
+  {
+    return _heuristics;
+  }
+
+  /**\brief Prints the optimizer's stats and, after a work-stealing
+   * search, the busy time and steal counts of every thread.
+   *
+   * @param os std::ostream& the stream to write to.
+   */
+  virtual void write(std::ostream& os = std::cout) override
+  {
+    Base::write(os);
+    if (_mode == BnBMode::WorkStealing)
+    {
+      _ws.write(os);
+    }
+  }
+
   /**\brief Override the virtual solve function.
    *
    * @param[in] g FaceDAG& The input.
@@ -117,13 +290,24 @@ class BranchAndBound : public Optimizer
   /**\brief Our own solve function, calling itself recursively.
    *
    * @param[in] g FaceDag& The input.
-   * @param[in] cost_until_now flop_t Reference for comparison of global optima.
+   * @param[in] solution_until_now OpPath The operations leading to g.
    * @param[in] parallel_depth flop_t Know the depth of recursion to switch openMP task parallelisation.
    * @param[in] source VertexDesc Current Vertex in the MetaDAG.
+   * @param[in] sleep Branches to skip with partial order reduction.
+   * @param[inout] solved SolvedState of g if g is searched in place,
+   *               otherwise nullptr and it is counted on g.
+   * @param[inout] bound State of the incremental lower bound on g if g is
+   *               searched in place, otherwise nullptr.
+   * @param[in] hint A sequence solving g to start with instead of running
+   *                 the heuristics, or nullptr.
+   * @param[in] path Checkpoint::Path of g if its depth is tracked.
    */
   OpSequence solve(
-      FaceDAG& g, const OpSequence solution_until_now,
-      const flop_t parallel_depth, const VertexDesc source) const;
+      FaceDAG& g, const OpPath& solution_until_now,
+      const flop_t parallel_depth, const VertexDesc source,
+      const SleepSet& sleep = SleepSet(), SolvedState* solved = nullptr,
+      LowerBound::State* bound = nullptr, const OpSequence* hint = nullptr,
+      const Checkpoint::Path& path = Checkpoint::Path()) const;
 
  protected:
   /**\brief Traverses all operations on a face DAG and executes
@@ -131,22 +315,161 @@ class BranchAndBound : public Optimizer
   template<typename V_ACTION, typename E_ACTION>
   void traverse_elims(const FaceDAG&, V_ACTION&, E_ACTION&) const;
 
-  /**\brief Updates the global optimum of the branch and bound
-   * with a new solution candidate. */
+  /**\brief Collects the operations branched on at a face DAG.
+   *
+   * @param[in] g The face DAG.
+   * @returns The operations in the order traverse_elims(...) visits them,
+   *          in the arena of the calling thread.
+   */
+  ArenaVector<OpSequence> branches(const FaceDAG& g) const;
+
+  /**\brief Solves a face DAG with the greedy and the min-fill-in
+   * heuristics and returns the cheaper sequence.
+   *
+   * @param[in] g The face DAG. Restored before returning.
+   * @param[in] trail The trail to restore g with.
+   */
+  OpSequence heuristic_solve(FaceDAG& g, Trail& trail) const;
+
+  /**\brief Estimates the number of nodes of the search tree on root
+   * that the lower bound does not cut, with Knuth's random probes.
+   *
+   * Every probe descends from root along random branches the bound does
+   * not cut with the current global optimum. At each depth, the product
+   * of the numbers of such branches along the path estimates the number
+   * of nodes at this depth. The estimate is unbiased for a fixed global
+   * optimum and ignores the cuts by the heuristics of a node. A probe
+   * evaluates the lower bound at most _probe_budget times and ignores the
+   * depths below, which makes the estimate too small on large trees.
+   * @param[in] root The face DAG at the root of the search.
+   * @param[in] probes Number of probes to average.
+   * @param[in] cancelled Polled between two evaluations of the bound.
+   *            The probes stop once it returns true.
+   * @returns The mean estimated number of nodes, 0 if cancelled.
+   */
+  double probe_search_space(
+      const FaceDAG& root, const size_t probes,
+      const std::function<bool()>& cancelled) const;
+
+  /**\brief Starts writing improvements of the global optimum to
+   * adm_glob_opt_s, at most once per output interval.
+   *
+   * @param[in] writer The thread to write with. Writes a last time
+   * when it stops.
+   */
+  void start_glob_opt_writer(PeriodicThread& writer) const;
+
+  /**\brief Starts writing a line on the progress of the search to
+   * std::cout once per output interval and, if _progress_path is set,
+   * the same values as a JSON object per line to that file.
+   *
+   * The line holds the estimated size of the search tree, see
+   * probe_search_space(...), the global optimum and the stats. The
+   * search threads are not interrupted for it.
+   * @param[in] reporter The thread to write with. Stop it without a last
+   * call, as the estimates are meaningless once the search completed.
+   */
+  void start_progress_reporter(PeriodicThread& reporter) const;
+
+  /**\brief Starts writing a checkpoint of the search on root to
+   * _checkpoint_path once per checkpoint interval.
+   *
+   * The file is replaced atomically, so an interrupted write leaves the
+   * previous checkpoint intact.
+   * @param[in] writer The thread to write with. Writes a last time when
+   * it stops.
+   * @param[in] root Fingerprint of the face DAG at the root.
+   */
+  void start_checkpoint_writer(
+      PeriodicThread& writer, const FaceDAGHash& root) const;
+
+  /**\brief Seeds the global optimum with _initial_solution if it is set
+   * and solves g. Its costs are recomputed on g.
+   *
+   * @param[in] g The face DAG at the root.
+   * @returns True if the global optimum was seeded.
+   */
+  bool seed_glob_opt(const FaceDAG& g) const;
+
+  /**\brief Prepares the tracking of completed subtrees for a search
+   * and resumes from _resume_path if it is set and exists.
+   *
+   * @param[in] root Fingerprint of the face DAG at the root.
+   * @returns True if the search was resumed.
+   * @throws std::runtime_error if the checkpoint cannot be read.
+   */
+  bool init_checkpoint(const FaceDAGHash& root) const;
+
+  /**\brief Hands the last untried branch of the shallowest node on the
+   * current thread's search path to the work-stealing deques.
+   *
+   * @param[in] g The face DAG the current thread is searching in place.
+   */
+  void donate(const FaceDAG& g) const;
+
+  /// Cost of the global optimum. Safe to read without a lock.
   ADM_ALWAYS_INLINE
+  flop_t glob_opt_cost() const
+  {
+    return _glob_opt_c.load(std::memory_order_relaxed);
+  }
+
+  /// The global optimal sequence. Safe to read without a lock.
+  std::shared_ptr<const OpSequence> glob_opt() const
+  {
+    return std::atomic_load(&_glob_opt_s);
+  }
+
+  /// Forget the global optimum. Every solve(...) starts with this.
+  void reset_glob_opt() const
+  {
+    _glob_opt_c = OpSequence::make_max().cost();
+    std::atomic_store(
+        &_glob_opt_s,
+        std::make_shared<const OpSequence>(OpSequence::make_max()));
+  }
+
+  /**\brief Updates the global optimum of the branch and bound
+   * with a new solution candidate. Lock-free.
+   *
+   * The cost is lowered first, so pruning sees it immediately. A copy
+   * of s is then published, unless a cheaper sequence was published
+   * in the meantime.
+   */
   bool update_global_opt(const OpSequence& s) const
   {
-    bool updated = false;
-    if (s.cost() < _glob_opt_s.cost())
+    flop_t c = glob_opt_cost();
+    do
     {
-      _glob_opt_s = s;
-      this->_stats.add(GlobUpdate);
-      updated = true;
-      std::ofstream o("adm_glob_opt_s");
-      s.write(o);
-      o.close();
+      if (s.cost() >= c)
+      {
+        return false;
+      }
+    } while (!_glob_opt_c.compare_exchange_weak(
+        c, s.cost(), std::memory_order_relaxed));
+
+    auto p = std::make_shared<const OpSequence>(s);
+    auto old = glob_opt();
+    while (old->cost() > s.cost() &&
+           !std::atomic_compare_exchange_weak(&_glob_opt_s, &old, p))
+    {}
+    this->_stats.add(GlobUpdate);
+    return true;
+  }
+
+  /**\brief Updates the global optimum with prefix followed by s.
+   *
+   * The path is only materialised if it is cheaper than the global optimum.
+   */
+  bool update_global_opt(const OpPath& prefix, const OpSequence& s) const
+  {
+    if (prefix.cost() + s.cost() >= glob_opt_cost())
+    {
+      return false;
     }
-    return updated;
+    OpSequence res = prefix.sequence();
+    res += s;
+    return update_global_opt(res);
   }
 
   /// To find greedy solutions.
@@ -164,8 +487,58 @@ class BranchAndBound : public Optimizer
   /// The maximum task-spawning depth.
   plength_t _parallel_depth;
 
+  /// How the search tree is distributed to the threads.
+  BnBMode _mode;
+
+  /// Partial order reduction with sleep sets.
+  bool _por;
+
+  /// When to run the heuristics at a node.
+  HeuristicPolicy _heuristics;
+
+  /// Random probes per progress output.
+  size_t _probes = 16;
+  /// Lower bound evaluations per probe, 0 for no limit.
+  size_t _probe_budget = 1000;
+
+  /// Completed subtrees of the search, to resume it.
+  mutable admission::Checkpoint _checkpoint;
+  fs::path _checkpoint_path;
+  double _checkpoint_interval = 600;
+  size_t _checkpoint_depth = 3;
+  fs::path _resume_path;
+
+  /// Solution to start the global optimum with.
+  fs::path _initial_solution;
+
+  /// Copy of the face DAG the last search started on, for the probes.
+  mutable std::unique_ptr<const FaceDAG> _root;
+
+  /// An open node of the search tree in BnBMode::WorkStealing.
+  struct OpenNode
+  {
+    /// The face DAG of the node.
+    std::unique_ptr<FaceDAG> g;
+    /// The operations leading from the root to the node.
+    OpPath prefix;
+    /// Depth of the node in the search tree.
+    flop_t depth = 0;
+    /// Checkpoint::Path of the node if its depth is tracked.
+    Checkpoint::Path path;
+  };
+
+  /// Deques of open nodes in BnBMode::WorkStealing.
+  mutable admission::WorkStealingQueues<OpenNode> _ws;
+
+  /// Cost of the global optimum, used for pruning by all threads.
+  mutable std::atomic<flop_t> _glob_opt_c;
+
   /// Global optimal sequence allowing to compare results bewteen threads.
-  mutable admission::OpSequence _glob_opt_s;
+  /// Replaced as a whole, only accessed with std::atomic_load/-store.
+  mutable std::shared_ptr<const OpSequence> _glob_opt_s;
+
+  /// Bounds of face DAGs that were already searched.
+  mutable admission::TranspositionTable _tt;
 };
 
 ADM_REGISTER_TYPE(BranchAndBound, BranchAndBound);
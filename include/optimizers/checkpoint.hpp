@@ -0,0 +1,159 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/hash.hpp"
+#include "operations/op_sequence.hpp"
+#include "optimizers/estimator.hpp"
+#include "optimizers/optimizer_stats.hpp"
+
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stddef.h>
+#include <string>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Optimizers
+ * \ @{
+ */
+
+/**\brief The completed subtrees of a branch and bound search, to resume
+ * it after it was interrupted.
+ *
+ * A subtree is identified by its Path, the ordinals of the branches leading
+ * from the root to it. The branches of a face DAG are enumerated in the same
+ * order whenever it is read again, so the paths stay valid as long as the
+ * search is resumed with the same options. Unlike the operations, they tell
+ * apart branches that apply the same operations to different vertices.
+ * Only subtrees up to a depth are tracked. A completed subtree replaces the
+ * completed subtrees below it, so the open frontier of the search is the
+ * complement of a small set.
+ *
+ * Skipping a completed subtree on resume is safe as long as the global
+ * optimum is restored as well: every sequence in the subtree either costs
+ * at least the global optimum at the time it completed or updated it.
+ * Hence write(...) reads the global optimum after the completed subtrees.
+ */
+class Checkpoint
+{
+ public:
+  /// Ordinals of the branches leading to a subtree, separated by dots.
+  typedef std::string Path;
+
+  Checkpoint() = default;
+  Checkpoint(const Checkpoint&) = delete;
+
+  /**\brief Forgets all completed subtrees.
+   *
+   * @param[in] depth Deepest subtree to track, 0 disables tracking.
+   */
+  void reset(const size_t depth)
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _completed.clear();
+    _depth = depth;
+    _resumed = false;
+  }
+
+  /// True if completed subtrees were read by read(...) since the last reset.
+  bool resumed() const
+  {
+    return _resumed;
+  }
+
+  /// True if subtrees at depth d are tracked.
+  bool tracks(const size_t d) const
+  {
+    return d > 0 && d <= _depth;
+  }
+
+  /// Number of completed subtrees tracked.
+  size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    return _completed.size();
+  }
+
+  /**\brief Identifies the face DAG a checkpoint belongs to.
+   *
+   * Unlike face_dag_hash(...), it includes the sizes of the Jacobians,
+   * which do not change during a search but between face DAGs of the
+   * same shape.
+   * @param[in] g The face DAG at the root.
+   * @returns The fingerprint of g.
+   */
+  static FaceDAGHash fingerprint(const FaceDAG& g);
+
+  /**\brief The path of a child of a subtree.
+   *
+   * @param[in] parent The path of the subtree, empty for the root.
+   * @param[in] c Ordinal of the branch leading to the child.
+   * @returns The path of the child.
+   */
+  static Path child(const Path& parent, const size_t c)
+  {
+    return parent.empty() ? std::to_string(c) :
+                            parent + "." + std::to_string(c);
+  }
+
+  /// Records the subtree at path as completed.
+  void complete(const Path& path);
+
+  /// True if the subtree at path was completed.
+  bool completed(const Path& path) const;
+
+  /**\brief Writes the state of a search.
+   *
+   * @param[inout] os The stream to write to.
+   * @param[in] root Fingerprint of the face DAG at the root.
+   * @param[in] incumbent Returns the global optimum. It is called after
+   *            the completed subtrees were copied, so the optimum written
+   *            accounts for every subtree written.
+   * @param[in] stats The counters of the search.
+   * @param[in] est The estimator of the search.
+   */
+  void write(
+      std::ostream& os, const FaceDAGHash& root,
+      const std::function<OpSequence()>& incumbent,
+      const OptimizerStats& stats, const Estimator& est) const;
+
+  /**\brief Reads the state of a search written by write(...) and adds
+   * it to this, to the counters and to the estimator.
+   *
+   * @param[inout] is The stream to read from.
+   * @param[in] root Fingerprint of the face DAG at the root.
+   * @param[out] incumbent The global optimum.
+   * @param[inout] stats The counters of the search.
+   * @param[inout] est The estimator of the search.
+   * @returns False, without changing anything, if the checkpoint was
+   *          written for a different face DAG.
+   * @throws std::runtime_error if is does not hold a checkpoint.
+   */
+  bool read(
+      std::istream& is, const FaceDAGHash& root, OpSequence& incumbent,
+      OptimizerStats& stats, Estimator& est);
+
+ private:
+  mutable std::mutex _m;
+  /// Paths of the completed subtrees. Subtrees below one of them are removed.
+  std::set<Path> _completed;
+  size_t _depth = 0;
+  bool _resumed = false;
+};
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // CHECKPOINT_HPP
@@ -0,0 +1,53 @@
+#ifndef DECOMPOSITION_HPP
+#define DECOMPOSITION_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "operations/op_sequence.hpp"
+
+// ************************** Forward declarations ************************** //
+
+namespace admission
+{
+class Optimizer;
+}
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Optimizers
+ * @{
+ */
+
+/**\brief Solves the weakly connected components of a face DAG separately.
+ *
+ * Operations on different components never interact, so the optimal
+ * sequence of g is the concatenation of the optimal sequences of its
+ * components and its cost is their sum. The search spaces of the
+ * components are thus added instead of multiplied.
+ *
+ * Parallel optimizers solve one component after the other with all
+ * threads. The components are solved in parallel by sequential
+ * optimizers. If g is connected, op.solve(g) is returned.
+ *
+ * The operations of the result refer to vertices by their indices,
+ * so it can be applied to g.
+ *
+ * @param[in] op The optimizer to solve the components with.
+ * @param[in] g The face DAG. It is not modified if g is disconnected.
+ * @returns OpSequence The concatenated sequences of the components.
+ */
+OpSequence solve_components(Optimizer& op, FaceDAG& g);
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // DECOMPOSITION_HPP
@@ -6,8 +6,7 @@
 #include "admission_config.hpp"
 #include "graph/DAG.hpp"
 
-#include <boost/graph/adjacency_list.hpp>
-
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <stddef.h>
@@ -23,106 +22,108 @@ namespace admission
  * \ @{
  */
 
-/**\brief Struct to estimate the length size of a branch and bound search space */
+/**\brief Struct to estimate the length size of a branch and bound search space
+ *
+ * Every thread counts the branches and cuts per depth of the search tree
+ * in its own shard, without locks. The shards are merged into a snapshot
+ * of the estimates by merge(), which a thread calls after it added a
+ * number of samples and which calc_est(...) reads.
+ *
+ * The snapshot multiplies the mean number of branches that were not cut
+ * per depth, which assumes that the visited nodes are representative of
+ * their depth. A random-probe estimate of the pruned tree computed by the
+ * search can be stored next to it, see set_probe_estimate(...).
+ */
 struct Estimator
 {
-  struct Data
-  {
-    size_t n_samples = 0;
-    // size_t n_cut = 0;
-    double estimate = 1;
-  };
+  /// Samples of a thread after which it merges the shards.
+  static constexpr size_t merge_interval = 1024;
 
   Estimator() = default;
+  Estimator(const Estimator&) = delete;
 
-  void init(const FaceDAG& g)
+  ~Estimator()
   {
-    _estimates.reserve(2 * num_edges(g) + num_vertices(g));
-    _estimates.resize(0);
+    clear();
   }
 
-  double calc_est(const size_t d)
+  /// Forgets all samples and prepares for the depths of a search on g.
+  void init(const FaceDAG& g);
+
+  /**\brief Returns the estimated size of a subtree at depth d, from
+   * the last merge. Complexity O(1).
+   */
+  double calc_est(const size_t d) const;
+
+  /// Counts a branch at depth d that was cut.
+  void add_cut(const size_t d)
   {
-    // We first calculate an estimate of the entire search tree without
-    // cutting branches.
-    double est = 1.0;
-    double leaves = 1.0;
-    for (size_t k = d; k < _estimates.size(); ++k)
+    if (Level* l = level(d))
     {
-      leaves *= _estimates[k].estimate;
-      est += leaves;
+      l->cuts.fetch_add(1, std::memory_order_relaxed);
     }
-    // ADM_DEBUG(estimator_v) << "On level d=" << d << " uncut size=" << est << std::endl;
-
-    // // An then subtract the estimated size of all cut brunches.
-    // std::vector<double> _cuts(_estimates.size(), 1.0);
-    // double est_cut = 1.0;
-    // double est_leaves = 1.0;
-    // double pos_cut = 1.0;
-    // for (size_t n=d; n<_estimates.size(); ++n) {
-    //   for (size_t k=d; k<n+1; ++k) {
-    //     pos_cut *=_estimates[k].estimate;
-    //   }
-    //   for (size_t k=n+1; k<_estimates.size(); ++k) {
-    //     est_leaves *= _estimates[k].estimate;
-    //     est_cut += est_leaves;
-    //   }
-    //   ADM_DEBUG(estimator_v) << "On level n=" << n
-    //     << "average children=" << _estimates[n].estimate
-    //     << " possible cuts= " << pos_cut << " cuts=" << _estimates[n].n_cut
-    //     << " with total size=" << est_cut * _estimates[n].n_cut << std::endl;
-
-    //   est -= est_cut * _estimates[n].n_cut;
-    //   est_cut = 1.0;
-    //   pos_cut = 1.0;
-    //   est_leaves = 1.0;
-    // }
-    ADM_DEBUG(estimator_v) << "On level d=" << d << " cut size=" << est
-                           << std::endl
-                           << std::endl;
-    return est;
   }
 
-  void add_cut(const size_t d)
+  /// Counts a node at depth d with v branches.
+  void add_sample(const size_t d, const double& v);
+
+  /// Sums up the shards into the estimates read by calc_est(...).
+  void merge();
+
+  /// Writes the counters of all depths, summed over the shards.
+  void save(std::ostream& os) const;
+
+  /// Adds counters written by save(...) to the shard of the calling thread.
+  void load(std::istream& is);
+
+  /// Stores an estimate of the size of the pruned search tree.
+  void set_probe_estimate(const double n)
   {
-    #pragma omp critical
-    {
-      size_t& s = _estimates.at(d).n_samples;
-      double& e = _estimates.at(d).estimate;
-      e -= 1.0 / s;
-      if (d < 4)
-      {
-        ADM_DEBUG(estimator_v)
-            << "Removing Branch: depth=" << d << " new avg=" << e << std::endl;
-      }
-    }
+    _probe.store(n, std::memory_order_relaxed);
   }
 
-  void add_sample(const size_t d, const double& v)
+  /// The last estimate stored by set_probe_estimate(...), 0 if none.
+  double probe_estimate() const
   {
-    if (v < 1.0)
-    {
-      return;
-    }
-    #pragma omp critical
-    {
-      if (_estimates.size() <= d)
-      {
-        _estimates.resize(d + 1);
-      }
-      size_t& s = _estimates.at(d).n_samples;
-      double& e = _estimates.at(d).estimate;
-      e = (e * s + v) / (s + 1);
-      if (d < 4)
-      {
-        ADM_DEBUG(estimator_v)
-            << "Adding Estimate: depth=" << d << " value=" << v
-            << " new avg=" << e << std::endl;
-      }
-    }
+    return _probe.load(std::memory_order_relaxed);
   }
 
-  std::vector<Data> _estimates;
+ private:
+  /// Counters of a depth.
+  struct Level
+  {
+    std::atomic<size_t> samples{0};
+    std::atomic<size_t> branches{0};
+    std::atomic<size_t> cuts{0};
+  };
+
+  /// The counters of the threads sharing a slot, on cache lines of their own.
+  struct alignas(64) Shard
+  {
+    /// Counters of all depths, allocated on first use.
+    std::atomic<Level*> levels{nullptr};
+    /// Samples since the last merge of the shard.
+    std::atomic<size_t> pending{0};
+  };
+
+  static constexpr size_t n_shards = 64;
+
+  /// Counters of depth d of the calling thread, nullptr if d is too deep.
+  Level* level(const size_t d);
+
+  /// Frees the counters of all shards.
+  void clear();
+
+  Shard _shards[n_shards];
+  /// Number of depths counted.
+  size_t _depths = 0;
+  /// Deepest depth sampled so far.
+  std::atomic<size_t> _deepest{0};
+  /// Estimates of the subtree sizes per depth of the last merge.
+  std::shared_ptr<const std::vector<double>> _est;
+  /// Set while a thread merges.
+  std::atomic_flag _merging = ATOMIC_FLAG_INIT;
+  std::atomic<double> _probe{0};
 };
 
 /**
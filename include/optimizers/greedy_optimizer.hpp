@@ -16,6 +16,7 @@
 namespace admission
 {
 class LowerBound;
+class Trail;
 }
 
 // **************************** Header contents ***************************** //
@@ -105,19 +106,11 @@ class GreedyOptimizer : public Optimizer
    * and apply it.
    *
    * @param[in] g Reference to the FaceDAG.
+   * @param[in] diagnostics Write diagnostics if they are turned on.
+   * @param[inout] trail Records all modifications of g if not nullptr.
    */
-  OpSequence greedy_solve(FaceDAG&, bool = true) const;
-
- protected:
-  ///\name Internal solution helpers.
-  ///@{
-  /**\brief Returns either a preaccumulation that merges
-   *        two vertices or the cheaptest elimination.
-   * @param g Reference to the face DAG we are searching.
-   * @returns OpSequence containing a single elimination.
-   */
-  OpSequence get_greedy_elim_on_any_graph(const admission::FaceDAG& g) const;
-  ///@}
+  OpSequence greedy_solve(
+      FaceDAG&, bool = true, Trail* trail = nullptr) const;
 };
 
 ADM_REGISTER_TYPE(GreedyOptimizer, GreedyOptimizer);
@@ -0,0 +1,155 @@
+#ifndef HEURISTIC_POLICY_HPP
+#define HEURISTIC_POLICY_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "optimizers/estimator.hpp"
+
+#include <atomic>
+#include <stddef.h>
+#include <string>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Optimizers
+ * \ @{
+ */
+
+/// Rules deciding at which nodes of a search the heuristics run.
+enum class HeuristicMode
+{
+  /// At every node.
+  Always,
+  /// At the nodes up to a depth.
+  Depth,
+  /// At the nodes whose estimated subtree is large enough.
+  Estimate,
+  /// Less often the longer they have not improved the global optimum.
+  Adaptive
+};
+
+/**\brief Converts the name of a heuristic mode
+ * ("always", "depth", "estimate" or "adaptive").
+ *
+ * @param[in] s The name of the mode.
+ * @returns The mode.
+ * @throws std::runtime_error if s does not name a mode.
+ */
+HeuristicMode to_heuristic_mode(const std::string& s);
+
+/**\brief Decides at which nodes the branch and bound runs its greedy
+ * heuristics to improve the global optimum.
+ *
+ * The heuristics cost more than branching on small face DAGs, while
+ * they rarely improve the global optimum deep in the search tree.
+ * The root is always solved by the heuristics, to start with a
+ * global optimum.
+ *
+ * In HeuristicMode::Adaptive, the heuristics run at every node until
+ * they failed to improve the global optimum in a window of runs in a row.
+ * Then they only run at every second node, after the next window of
+ * failures at every fourth node and so on, until they improve it again.
+ */
+class HeuristicPolicy
+{
+ public:
+  HeuristicPolicy() = default;
+  HeuristicPolicy(const HeuristicPolicy&) = delete;
+
+  /// Selects the rule.
+  void set_mode(const HeuristicMode m)
+  {
+    _mode = m;
+  }
+
+  /// Sets the deepest node HeuristicMode::Depth runs the heuristics at.
+  void set_depth(const size_t d)
+  {
+    _depth = d;
+  }
+
+  /// Sets the smallest estimated subtree HeuristicMode::Estimate runs
+  /// the heuristics on.
+  void set_min_subtree(const double n)
+  {
+    _min_subtree = n;
+  }
+
+  /// Sets the number of failures after which HeuristicMode::Adaptive
+  /// halves the frequency of the heuristics.
+  void set_window(const size_t n)
+  {
+    _window = n ? n : 1;
+  }
+
+  /**\brief Lets a child take the rest of the heuristic solution of its
+   *        parent if the parent's solution starts with the branch to it.
+   */
+  void set_reuse(const bool on)
+  {
+    _reuse = on;
+  }
+
+  /// True if children reuse the heuristic solution of their parent.
+  bool reuse() const
+  {
+    return _reuse;
+  }
+
+  /// Forgets the failures. Every search starts with this.
+  void reset() const
+  {
+    _misses = 0;
+    _nodes = 0;
+  }
+
+  /**\brief Decides whether the heuristics run at a node.
+   *
+   * @param[in] depth Depth of the node in the search tree.
+   * @param[in] est Estimator of the search space, read for
+   *                HeuristicMode::Estimate.
+   * @returns True if the heuristics should run.
+   */
+  bool run(const size_t depth, const Estimator& est) const;
+
+  /**\brief Records the outcome of running the heuristics.
+   *
+   * @param[in] improved True if they improved the global optimum.
+   */
+  void record(const bool improved) const
+  {
+    if (improved)
+    {
+      _misses.store(0, std::memory_order_relaxed);
+    }
+    else
+    {
+      _misses.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  HeuristicMode _mode = HeuristicMode::Always;
+  size_t _depth = 4;
+  double _min_subtree = 1e6;
+  size_t _window = 64;
+  bool _reuse = false;
+
+  /// Runs without improving the global optimum in a row.
+  mutable std::atomic<size_t> _misses{0};
+  /// Nodes seen in HeuristicMode::Adaptive.
+  mutable std::atomic<size_t> _nodes{0};
+};
+
+/**
+ * @}
+ */
+
+}  // end namespace admission
+
+#endif  // HEURISTIC_POLICY_HPP
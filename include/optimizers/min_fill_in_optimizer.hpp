@@ -49,7 +49,14 @@ class MinFillInOptimizer : public GreedyOptimizer
     return min_fill_in_solve(g);
   }
 
-  OpSequence min_fill_in_solve(FaceDAG& g, bool = true) const;
+  /** \brief Solves g with the min-fill-in heuristic.
+   *
+   * @param[in] g Reference to the FaceDAG.
+   * @param[in] _write Add the solution to the meta DAG.
+   * @param[inout] trail Records all modifications of g if not nullptr.
+   */
+  OpSequence min_fill_in_solve(
+      FaceDAG& g, bool = true, Trail* trail = nullptr) const;
   ///@}
 
  protected:
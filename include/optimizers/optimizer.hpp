@@ -66,6 +66,12 @@ class Optimizer
     _output_mode = hr;
   }
 
+  /// Also write the progress updates as JSON lines to p, if p is not empty.
+  virtual void set_progress_path(const fs::path& p)
+  {
+    _progress_path = p;
+  }
+
   /// Reset the internal elimination and branch/cut counters.
   virtual void reset()
   {
@@ -103,7 +109,7 @@ class Optimizer
    *
    * @param os std::ostream& the stream to write to.
    */
-  void write(std::ostream& os = std::cout)
+  virtual void write(std::ostream& os = std::cout)
   {
     _stats.write(os);
   }
@@ -146,6 +152,7 @@ class Optimizer
   ///@{
   /** \brief  Used to determine whether a DAG is solved.
    *
+   * Counts a SolvedState on g. Complexity O(|V|+|E|).
    * @param g FaceDAG& the face DAG to check.
    * @returns bool true if solved.
    */
@@ -160,6 +167,7 @@ class Optimizer
 
   bool _output_mode = true;
   double _interval = 1.0;
+  fs::path _progress_path;
 
   /// Diagnostics switch.
   bool _diagnostics = false;
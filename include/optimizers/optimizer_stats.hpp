@@ -4,8 +4,10 @@
 // ******************************** Includes ******************************** //
 
 #include "admission_config.hpp"
+#include "misc/thread_slot.hpp"
 
 #include <iostream>
+#include <omp.h>
 #include <stddef.h>
 
 // **************************** Header contents ***************************** //
@@ -28,22 +30,81 @@ enum StatT
   Branch,
   Bound,
   GlobUpdate,
-  Leaf
+  Leaf,
+  TTHit,
+  TTMiss,
+  PORSkip,
+  /// Subtrees skipped as a checkpoint recorded them as completed.
+  Resumed,
+  /// Nodes the heuristics ran at, were skipped at by the HeuristicPolicy
+  /// or reused the heuristic solution of the parent at.
+  HeurRun,
+  HeurSkip,
+  HeurReuse,
+  /// Calls of operator new during the search, see heap_allocations().
+  HeapAlloc,
+  /// Number of tracked values, keep last.
+  NStatT
 };
 
-/// Struct for storing a benchmark of the optimizers operations.
+/// Phases of a search node whose runtime can be logged.
+enum TimeT
+{
+  /// Copies of face DAGs.
+  CopyTime = 0,
+  /// Applying and rolling back operations.
+  ApplyTime,
+  /// Evaluating and updating the lower bound.
+  BoundTime,
+  /// Running the heuristics.
+  HeuristicTime,
+  /// Collecting the branches.
+  TraversalTime,
+  /// Number of tracked phases, keep last.
+  NTimeT
+};
+
+/**\brief Struct for storing a benchmark of the optimizers operations.
+ *
+ * Every thread counts in its own shard, which fills whole cache lines,
+ * so threads do not invalidate each other's counters. The shards are
+ * summed up when the counters are read.
+ */
 struct OptimizerStats
 {
  public:
-  size_t data[8] = {0, 0, 0, 0, 0, 0};
+  /// Number of shards. Threads beyond it share shards.
+  static constexpr size_t n_shards = 64;
 
   /// Reset all tracked values to 0.
   void reset()
   {
-    for (size_t i = 0; i < 8; ++i)
+    for (Shard& s : _shards)
+    {
+      s = Shard();
+    }
+  }
+
+  /// Returns the sum of a counter over all threads.
+  size_t get(const StatT& what) const
+  {
+    size_t res = 0;
+    for (const Shard& s : _shards)
+    {
+      res += s.data[what];
+    }
+    return res;
+  }
+
+  /// Returns the time spent in a phase in seconds, summed over all threads.
+  double seconds(const TimeT& what) const
+  {
+    double res = 0;
+    for (const Shard& s : _shards)
     {
-      data[i] = 0;
+      res += s.time[what];
     }
+    return res;
   }
 
   /**\brief Critical addition, still correct,
@@ -55,14 +116,14 @@ struct OptimizerStats
   void add(const StatT& what, const ptrdiff_t& i = 1)
   {
 #if ADM_STATS
+    size_t& d = shard().data[what];
     #pragma omp atomic
-    data[what] += i;
+    d += i;
 #endif  // ADM_STATS
   }
 
   /**\brief Addition, may result in false results
-   * if multiple threads try to increment at the same
-   * time.
+   * if multiple threads share a shard.
    *
    * @param what Tag of the value to increment
    * @param i value to add. Default value is 1
@@ -70,7 +131,21 @@ struct OptimizerStats
   void non_critical_add(const StatT& what, const ptrdiff_t& i = 1)
   {
 #if ADM_STATS
-    data[what] += i;
+    shard().data[what] += i;
+#endif  // ADM_STATS
+  }
+
+  /**\brief Adds time spent in a phase, see StatTimer.
+   *
+   * @param what Tag of the phase.
+   * @param t Time in seconds.
+   */
+  void add_time(const TimeT& what, const double t)
+  {
+#if ADM_STATS
+    double& d = shard().time[what];
+    #pragma omp atomic
+    d += t;
 #endif  // ADM_STATS
   }
 
@@ -83,8 +158,8 @@ struct OptimizerStats
   void write_human_readable(std::ostream& os = std::cout)
   {
 #if ADM_STATS
-    os << " Search space: " << data[Perf] << " Cuts: " << data[Bound]
-       << " Branches : " << data[Branch] << " Leaves: " << data[Leaf] << "\r";
+    os << " Search space: " << get(Perf) << " Cuts: " << get(Bound)
+       << " Branches : " << get(Branch) << " Leaves: " << get(Leaf) << "\r";
 #endif  // ADM_STATS
   }
 
@@ -94,10 +169,101 @@ struct OptimizerStats
   void write(std::ostream& os = std::cout)
   {
 #if ADM_STATS
+    size_t data[NStatT];
+    for (size_t i = 0; i < NStatT; ++i)
+    {
+      data[i] = get(StatT(i));
+    }
     os << "Statistics:"
        << "\n\tSearch space: " << data[Perf] << "\n\tCuts: " << data[Bound]
-       << "\n\tBranches: " << data[Branch] << "\n\tLeaves: " << data[Leaf]
-       << std::endl;
+       << "\n\tBranches: " << data[Branch] << "\n\tLeaves: " << data[Leaf];
+    if (data[TTHit] + data[TTMiss])
+    {
+      os << "\n\tTransposition table hits: " << data[TTHit]
+         << "\n\tTransposition table misses: " << data[TTMiss];
+    }
+    if (data[PORSkip])
+    {
+      os << "\n\tSkipped by partial order reduction: " << data[PORSkip];
+    }
+    if (data[Resumed])
+    {
+      os << "\n\tCompleted subtrees skipped on resume: " << data[Resumed];
+    }
+    if (data[HeurSkip] + data[HeurReuse])
+    {
+      os << "\n\tHeuristics run: " << data[HeurRun]
+         << "\n\tHeuristics skipped: " << data[HeurSkip]
+         << "\n\tHeuristic solutions reused: " << data[HeurReuse];
+    }
+    if (data[HeapAlloc])
+    {
+      os << "\n\tHeap allocations: " << data[HeapAlloc];
+    }
+    static const char* const phases[NTimeT] = {
+        "copies", "applying operations", "lower bounds", "heuristics",
+        "collecting branches"};
+    for (size_t i = 0; i < NTimeT; ++i)
+    {
+      if (const double t = seconds(TimeT(i)))
+      {
+        os << "\n\tTime in " << phases[i] << ": " << t << "s";
+      }
+    }
+    os << std::endl;
+#endif  // ADM_STATS
+  }
+
+  /**\brief Writes all counters and times to a single line,
+   * to be read by load(...).
+   */
+  void save(std::ostream& os) const
+  {
+    for (size_t i = 0; i < NStatT; ++i)
+    {
+      os << get(StatT(i)) << " ";
+    }
+    for (size_t i = 0; i < NTimeT; ++i)
+    {
+      os << seconds(TimeT(i)) << " ";
+    }
+    os << "\n";
+  }
+
+  /// Adds counters and times written by save(...) to the calling thread.
+  void load(std::istream& is)
+  {
+    Shard& s = shard();
+    for (size_t i = 0; i < NStatT; ++i)
+    {
+      size_t v = 0;
+      is >> v;
+      s.data[i] += v;
+    }
+    for (size_t i = 0; i < NTimeT; ++i)
+    {
+      double v = 0;
+      is >> v;
+      s.time[i] += v;
+    }
+  }
+
+  /**\brief Write the counters as the members of a JSON object,
+   * without the enclosing braces.
+   *
+   * @param[inout] os ostream to write to.
+   */
+  void write_json(std::ostream& os = std::cout)
+  {
+#if ADM_STATS
+    static const char* const names[NStatT] = {
+        "cons", "perf", "disc", "opti", "branch", "bound", "glob_update",
+        "leaf", "tt_hit", "tt_miss", "por_skip", "resumed", "heur_run",
+        "heur_skip", "heur_reuse", "heap_alloc"};
+    for (size_t i = 0; i < NStatT; ++i)
+    {
+      os << (i ? "," : "") << "\"" << names[i] << "\":" << get(StatT(i));
+    }
 #endif  // ADM_STATS
   }
 
@@ -107,11 +273,63 @@ struct OptimizerStats
   void write_log(std::ostream& os = std::cout)
   {
 #if ADM_STATS
-    os << " " << data[Cons] << " " << data[Perf] << " " << data[Opti] << " "
-       << data[Disc] << " " << data[Bound] << " " << data[Branch] << " "
-       << data[Leaf] << " " << data[GlobUpdate];
+    os << " " << get(Cons) << " " << get(Perf) << " " << get(Opti) << " "
+       << get(Disc) << " " << get(Bound) << " " << get(Branch) << " "
+       << get(Leaf) << " " << get(GlobUpdate) << " " << get(TTHit) << " "
+       << get(TTMiss) << " " << get(PORSkip);
 #endif  // ADM_STATS
   }
+
+ private:
+  /// The counters of a thread, on cache lines of their own.
+  struct alignas(64) Shard
+  {
+    size_t data[NStatT] = {0};
+    double time[NTimeT] = {0};
+  };
+
+  /// Returns the shard of the calling thread.
+  Shard& shard()
+  {
+    return _shards[thread_slot() % n_shards];
+  }
+
+  Shard _shards[n_shards];
+};
+
+/**\brief Adds the time from its construction to its destruction to a
+ * phase of an OptimizerStats.
+ *
+ * Only measures if ADMission is configured with ADM_STATS_TIMING, as
+ * reading the clock several times per node slows down the search.
+ */
+class StatTimer
+{
+ public:
+  StatTimer(
+      [[maybe_unused]] OptimizerStats& stats,
+      [[maybe_unused]] const TimeT what)
+#if ADM_STATS_TIMING
+      : _stats(stats), _what(what), _start(omp_get_wtime())
+#endif  // ADM_STATS_TIMING
+  {}
+
+  StatTimer(const StatTimer&) = delete;
+  StatTimer& operator=(const StatTimer&) = delete;
+
+  ~StatTimer()
+  {
+#if ADM_STATS_TIMING
+    _stats.add_time(_what, omp_get_wtime() - _start);
+#endif  // ADM_STATS_TIMING
+  }
+
+#if ADM_STATS_TIMING
+ private:
+  OptimizerStats& _stats;
+  const TimeT _what;
+  const double _start;
+#endif  // ADM_STATS_TIMING
 };
 
 /**
@@ -0,0 +1,147 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+#include "graph/hash.hpp"
+
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Optimizers
+ * \ @{
+ */
+
+/// Replacement policies of a TranspositionTable with a full bucket.
+enum class TTReplacement
+{
+  /// Replace the entry furthest from the root of the search tree.
+  Depth,
+  /// Always replace the least recently stored entry.
+  Always
+};
+
+/**\brief Converts the name of a replacement policy ("depth" or "always").
+ *
+ * @param[in] s The name of the policy.
+ * @returns The policy.
+ * @throws std::runtime_error if s does not name a policy.
+ */
+TTReplacement to_tt_replacement(const std::string& s);
+
+/**\brief Concurrent, set-associative transposition table for the
+ * branch and bound.
+ *
+ * Maps the FaceDAGHash of an intermediate face DAG to bounds of the cost
+ * of the optimal sequence solving it (its cost-to-go): a lower bound
+ * proven by a complete search of the face DAG and the cost of the best
+ * solution found for it.
+ * The memory of the table is fixed on resize(...). Buckets are protected
+ * by a striped set of locks.
+ */
+class TranspositionTable
+{
+ public:
+  /// A single record of the table.
+  struct Entry
+  {
+    FaceDAGHash key;
+    /// Lower bound of the cost-to-go.
+    flop_t lower = 0;
+    /// Cost of the best known sequence solving the face DAG.
+    flop_t upper = 0;
+    /// Depth of the face DAG in the search tree.
+    plength_t depth = 0;
+    bool used = false;
+  };
+
+  ///\name Constructors & Destructors.
+  ///@{
+  TranspositionTable() : _locks(new std::mutex[n_locks]) {}
+
+  TranspositionTable(const TranspositionTable&) = delete;
+  ///@}
+
+  /**\brief Reallocates the table and drops all entries.
+   *
+   * @param[in] megabytes Memory cap of the table. 0 disables the table.
+   * @param[in] policy Replacement policy applied to full buckets.
+   */
+  void resize(const size_t megabytes, const TTReplacement policy);
+
+  /// Drops all entries.
+  void clear();
+
+  /// True if the table has memory assigned.
+  bool enabled() const
+  {
+    return !_buckets.empty();
+  }
+
+  /// Number of entries the table can hold.
+  size_t capacity() const
+  {
+    return _buckets.size() * n_ways;
+  }
+
+  /**\brief Looks up the entry of a face DAG.
+   *
+   * @param[in] key The FaceDAGHash of the face DAG.
+   * @param[out] e Copy of the entry, if found.
+   * @returns true if the face DAG has an entry.
+   */
+  bool probe(const FaceDAGHash& key, Entry& e) const;
+
+  /**\brief Stores the bounds of a face DAG. Existing bounds of the
+   * same face DAG are tightened.
+   *
+   * @param[in] key The FaceDAGHash of the face DAG.
+   * @param[in] lower Lower bound of its cost-to-go.
+   * @param[in] upper Cost of the best known solution.
+   * @param[in] depth Depth of the face DAG in the search tree.
+   */
+  void store(
+      const FaceDAGHash& key, const flop_t lower, const flop_t upper,
+      const plength_t depth);
+
+ private:
+  /// Number of entries per bucket.
+  static constexpr size_t n_ways = 4;
+
+  /// Number of locks shared by all buckets.
+  static constexpr size_t n_locks = 256;
+
+  struct Bucket
+  {
+    Entry entries[n_ways];
+    /// Slot to overwrite next with the TTReplacement::Always policy.
+    unsigned char next = 0;
+  };
+
+  size_t bucket_of(const FaceDAGHash& key) const
+  {
+    return key.lo % _buckets.size();
+  }
+
+  std::vector<Bucket> _buckets;
+  std::unique_ptr<std::mutex[]> _locks;
+  TTReplacement _policy = TTReplacement::Depth;
+};
+
+/**
+ * \ @}
+ */
+
+}  // end namespace admission
+
+#endif  // TRANSPOSITION_TABLE_HPP
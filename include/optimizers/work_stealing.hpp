@@ -0,0 +1,227 @@
+#ifndef WORK_STEALING_HPP
+#define WORK_STEALING_HPP
+
+// ******************************** Includes ******************************** //
+
+#include "admission_config.hpp"
+
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <omp.h>
+#include <stddef.h>
+#include <thread>
+#include <utility>
+
+// **************************** Header contents ***************************** //
+
+namespace admission
+{
+
+/**
+ * \addtogroup Optimizers
+ * \ @{
+ */
+
+/// Counters of a single worker of the WorkStealingQueues.
+struct WorkerStats
+{
+  /// Time spent processing items in seconds.
+  double busy = 0;
+  /// Number of processed items.
+  size_t items = 0;
+  /// Number of items taken from the deque of another worker.
+  size_t steals = 0;
+  /// Number of items the worker split off its own search.
+  size_t donations = 0;
+};
+
+/**\brief Per-worker deques of open work items with stealing.
+ *
+ * Every worker pops the newest item of its own deque. A worker whose
+ * deque is empty steals the oldest item of another worker's deque, which
+ * is the item closest to the root of the search. If there is nothing to
+ * steal, the worker is idle. Busy workers query has_idle() and donate
+ * parts of their work with push(...), so subtrees are split on demand.
+ *
+ * run(...) returns once all pushed items are processed.
+ *
+ * @tparam Item Movable type of the work items.
+ */
+template<typename Item>
+class WorkStealingQueues
+{
+ public:
+  /**\brief Drops all items and sets up the deques of n workers.
+   *
+   * @param[in] n Number of workers.
+   */
+  void init(const size_t n)
+  {
+    _queues.reset(new Queue[n]);
+    _n = n;
+    _pending = 0;
+    _idle = 0;
+  }
+
+  /// Number of workers.
+  size_t size() const
+  {
+    return _n;
+  }
+
+  /// Pushes an item onto the deque of worker w.
+  void push(const size_t w, Item&& it)
+  {
+    ++_pending;
+    std::lock_guard<std::mutex> lock(_queues[w].m);
+    _queues[w].items.push_back(std::move(it));
+    _queues[w].n = _queues[w].items.size();
+  }
+
+  /// Pushes an item split off the work of worker w onto its deque.
+  void donate(const size_t w, Item&& it)
+  {
+    ++_queues[w].stats.donations;
+    push(w, std::move(it));
+  }
+
+  /// True if a worker waits for work.
+  bool has_idle() const
+  {
+    return _idle.load(std::memory_order_relaxed) > 0;
+  }
+
+  /// True if the deque of worker w is empty. Does not lock.
+  bool empty(const size_t w) const
+  {
+    return _queues[w].n.load(std::memory_order_relaxed) == 0;
+  }
+
+  /**\brief Processes items as worker w until all items are processed.
+   *
+   * Must be called by every worker, e.g. in an OpenMP parallel region.
+   * @param[in] w Id of the calling worker.
+   * @param[in] process Callable processing an Item&.
+   */
+  template<typename F>
+  void run(const size_t w, F&& process)
+  {
+    bool idle = false;
+    while (true)
+    {
+      Item it;
+      if (acquire(w, it))
+      {
+        if (idle)
+        {
+          --_idle;
+          idle = false;
+        }
+        const double t = omp_get_wtime();
+        process(it);
+        _queues[w].stats.busy += omp_get_wtime() - t;
+        ++_queues[w].stats.items;
+        --_pending;
+      }
+      else if (_pending.load() == 0)
+      {
+        break;
+      }
+      else
+      {
+        if (!idle)
+        {
+          ++_idle;
+          idle = true;
+        }
+        std::this_thread::yield();
+      }
+    }
+    if (idle)
+    {
+      --_idle;
+    }
+  }
+
+  /// The counters of worker w. Only valid if no worker runs.
+  const WorkerStats& stats(const size_t w) const
+  {
+    return _queues[w].stats;
+  }
+
+  /// Writes the counters of all workers.
+  void write(std::ostream& os = std::cout) const
+  {
+    os << "Work stealing:";
+    for (size_t w = 0; w < _n; ++w)
+    {
+      const WorkerStats& s = _queues[w].stats;
+      os << "\n\tThread " << w << ": busy " << s.busy << "s, items "
+         << s.items << ", steals " << s.steals << ", donations "
+         << s.donations;
+    }
+    os << std::endl;
+  }
+
+ private:
+  /// Deque and counters of a worker, on their own cache lines.
+  struct alignas(64) Queue
+  {
+    std::mutex m;
+    std::deque<Item> items;
+    /// Size of items, readable without the lock.
+    std::atomic<size_t> n{0};
+    WorkerStats stats;
+  };
+
+  /// Pops the newest own item or steals the oldest item of another worker.
+  bool acquire(const size_t w, Item& it)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_queues[w].m);
+      if (!_queues[w].items.empty())
+      {
+        it = std::move(_queues[w].items.back());
+        _queues[w].items.pop_back();
+        _queues[w].n = _queues[w].items.size();
+        return true;
+      }
+    }
+    for (size_t k = 1; k < _n; ++k)
+    {
+      Queue& q = _queues[(w + k) % _n];
+      if (q.n.load(std::memory_order_relaxed) == 0)
+      {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(q.m);
+      if (!q.items.empty())
+      {
+        it = std::move(q.items.front());
+        q.items.pop_front();
+        q.n = q.items.size();
+        ++_queues[w].stats.steals;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::unique_ptr<Queue[]> _queues;
+  size_t _n = 0;
+  /// Number of pushed items that were not processed completely.
+  std::atomic<size_t> _pending{0};
+  /// Number of workers without work.
+  std::atomic<size_t> _idle{0};
+};
+
+/**
+ * \ @}
+ */
+
+}  // end namespace admission
+
+#endif  // WORK_STEALING_HPP
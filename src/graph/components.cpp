@@ -0,0 +1,90 @@
+// ******************************** Includes ******************************** //
+
+#include "graph/components.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+#include <stddef.h>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/// Finds the representative of v and compresses the path to it.
+size_t find_root(std::vector<size_t>& parent, size_t v)
+{
+  while (parent[v] != v)
+  {
+    parent[v] = parent[parent[v]];
+    v = parent[v];
+  }
+  return v;
+}
+
+}  // end anonymous namespace
+
+std::vector<std::shared_ptr<FaceDAG>> split_components(const FaceDAG& g)
+{
+  const size_t n = num_vertices(g);
+  std::vector<size_t> parent(n);
+  for (size_t v = 0; v < n; ++v)
+  {
+    parent[v] = v;
+  }
+  BOOST_FOREACH(auto e, edges(g))
+  {
+    const size_t a = find_root(parent, source(e, g));
+    const size_t b = find_root(parent, target(e, g));
+    if (a != b)
+    {
+      parent[b] = a;
+    }
+  }
+
+  /* Number the components and map the vertices into them. */
+  const size_t none = n;
+  std::vector<size_t> comp_of_root(n, none);
+  std::vector<size_t> comp(n, none);
+  std::vector<VertexDesc> new_v(n);
+  std::vector<std::shared_ptr<FaceDAG>> res;
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    if (!in_degree(v, g) && !out_degree(v, g))
+    {
+      continue;
+    }
+    const size_t r = find_root(parent, v);
+    if (comp_of_root[r] == none)
+    {
+      comp_of_root[r] = res.size();
+      res.push_back(std::make_shared<FaceDAG>());
+      set_property(
+          *res.back(), boost::graph_previous_op,
+          get_property(g, boost::graph_previous_op));
+    }
+    comp[v] = comp_of_root[r];
+    FaceDAG& h = *res[comp[v]];
+    new_v[v] = add_vertex(h);
+    put(boost::vertex_acc_stat, h, new_v[v], get(boost::vertex_acc_stat, g, v));
+    put(boost::vertex_has_model, h, new_v[v],
+        get(boost::vertex_has_model, g, v));
+    put(boost::vertex_c_tan, h, new_v[v], get(boost::vertex_c_tan, g, v));
+    put(boost::vertex_c_adj, h, new_v[v], get(boost::vertex_c_adj, g, v));
+  }
+
+  BOOST_FOREACH(auto e, edges(g))
+  {
+    FaceDAG& h = *res[comp[source(e, g)]];
+    auto f = add_edge(new_v[source(e, g)], new_v[target(e, g)], h).first;
+    put(boost::edge_index, h, f, get(boost::edge_index, g, e));
+    put(boost::edge_size, h, f, get(boost::edge_size, g, e));
+  }
+  return res;
+}
+
+}  // end namespace admission
@@ -59,7 +59,7 @@ ADM_ALWAYS_INLINE index_t max_vertex_index(const Graph& g)
  * @param[inout] g_face reference to the graph we add an edge to.
  */
 ADM_ALWAYS_INLINE
-VertexDesc add_vertex_from(DAG& g, const EdgeDesc e, FaceDAG& g_face)
+VertexDesc add_vertex_from(DAG& g, const DAGEdgeDesc e, FaceDAG& g_face)
 {
   auto w = add_vertex(g_face);
   boost::put(
@@ -128,7 +128,7 @@ std::shared_ptr<FaceDAG> make_face_dag(const DAG& g_const)
   // Create the new face DAG.
   std::shared_ptr<FaceDAG> gfp = std::make_shared<FaceDAG>();
 
-  std::map<EdgeDesc, VertexDesc> e2v;
+  std::map<DAGEdgeDesc, VertexDesc> e2v;
   BOOST_FOREACH(auto orig_edge, edges(g))
   {
     e2v.emplace(orig_edge, admission::add_vertex_from(g, orig_edge, *gfp));
@@ -0,0 +1,84 @@
+// ******************************** Includes ******************************** //
+
+#include "graph/hash.hpp"
+
+#include "admission_config.hpp"
+#include "graph/DAG.hpp"
+#include "misc/arena.hpp"
+#include "misc/mix.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/// Order-dependent combination of a seed with a value.
+ADM_ALWAYS_INLINE uint64_t combine(const uint64_t seed, const uint64_t v)
+{
+  return mix(seed ^ (mix(v) + (seed << 6) + (seed >> 2)));
+}
+
+}  // end anonymous namespace
+
+FaceDAGHash face_dag_hash(const FaceDAG& g)
+{
+  auto acc_stat = boost::get(boost::vertex_acc_stat, g);
+  auto has_model = boost::get(boost::vertex_has_model, g);
+  auto c_tan = boost::get(boost::vertex_c_tan, g);
+  auto c_adj = boost::get(boost::vertex_c_adj, g);
+
+  /* Initial labels built from the local information of each vertex. */
+  ArenaScope scope;
+  ArenaVector<uint64_t> label(num_vertices(g), 0);
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    if (!in_degree(v, g) && !out_degree(v, g))
+    {
+      continue;
+    }
+    index_t i = in_degree(v, g) ? index(*(in_edges(v, g).first), g) : -1;
+    index_t j = out_degree(v, g) ? index(*(out_edges(v, g).first), g) : -1;
+    uint64_t h = combine(i, j);
+    h = combine(h, (acc_stat[v] ? 1 : 0) | (has_model[v] ? 2 : 0));
+    h = combine(h, has_model[v] ? c_tan[v] : 0);
+    h = combine(h, has_model[v] ? c_adj[v] : 0);
+    h = combine(h, in_degree(v, g));
+    label[v] = combine(h, out_degree(v, g));
+  }
+
+  /* One refinement round with commutative sums over the neighbours. */
+  FaceDAGHash res;
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    if (!in_degree(v, g) && !out_degree(v, g))
+    {
+      continue;
+    }
+    uint64_t p = 0;
+    uint64_t s = 0;
+    BOOST_FOREACH(auto e, in_edges(v, g))
+    {
+      p += mix(label[source(e, g)] ^ 0x5851f42d4c957f2dULL);
+    }
+    BOOST_FOREACH(auto e, out_edges(v, g))
+    {
+      s += mix(label[target(e, g)] ^ 0x14057b7ef767814fULL);
+    }
+    const uint64_t r = combine(combine(label[v], p), s);
+    res.hi += mix(r ^ 0xd6e8feb86659fd93ULL);
+    res.lo += mix(r + 0xa0761d6478bd642fULL);
+  }
+  res.hi = combine(res.hi, num_edges(g));
+  return res;
+}
+
+}  // end namespace admission
@@ -13,8 +13,10 @@
 
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include <utility>
+#include <vector>
 
 // **************************** Source contents ***************************** //
 
@@ -37,6 +39,14 @@ void read_mmchain(std::ifstream& stream, admission::DAG& g)
   stream >> buf;
   ne = std::stoul(buf);
 
+  // Sparse chains list the m x n sparsity pattern after every factor,
+  // which we skip. They are told apart by the number of inputs.
+  std::vector<std::string> in{
+      std::istream_iterator<std::string>(stream),
+      std::istream_iterator<std::string>()};
+  const bool has_pattern = in.size() != 3 * ne;
+  size_t pos = 0;
+
   // Add the vertex before the first edge.
   VertexDesc thisv, lastv = add_vertex(g);
 
@@ -47,9 +57,8 @@ void read_mmchain(std::ifstream& stream, admission::DAG& g)
     Fprime_exists[e] = false;
     Fbardot_exists[e] = true;
 
-    stream >> buf;
-    n[thisv] = std::stoul(buf);
-    stream >> buf;
+    n[thisv] = std::stoul(in.at(pos++));
+    buf = in.at(pos++);
 
     if (i == 0)
     {
@@ -59,12 +68,15 @@ void read_mmchain(std::ifstream& stream, admission::DAG& g)
     {
       throw matrix_dim_mismatch(
           std::stoul(buf), n[lastv],
-          std::string(" at ") + std::to_string(stream.tellg()) +
-              "th character of input!");
+          std::string(" at factor ") + std::to_string(i) + " of input!");
     }
 
-    stream >> buf;
-    c_adj[e] = c_tan[e] = std::stoul(buf);
+    c_adj[e] = c_tan[e] = std::stoul(in.at(pos++));
+
+    if (has_pattern)
+    {
+      pos += n[thisv] * n[lastv];
+    }
 
     lastv = thisv;
   }
@@ -104,7 +116,7 @@ void read_graphml(std::ifstream& stream, admission::DAG& g)
  * from the same file and specitfy the optimal solutions
  * for each category.
  */
-void read_graphml(std::ifstream& stream, admission::FaceDAG& g)
+void read_graphml(std::ifstream& stream, admission::BoostFaceDAG& g)
 {
   boost::dynamic_properties dp(boost::ignore_other_properties);
 
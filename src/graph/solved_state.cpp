@@ -0,0 +1,95 @@
+// ******************************** Includes ******************************** //
+
+#include "graph/solved_state.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+SolvedState::SolvedState(const FaceDAG& g)
+{
+  const size_t n = num_vertices(g);
+  _counts.resize(n);
+  _in_region.resize(n, false);
+  for (size_t v = 0; v < n; ++v)
+  {
+    set(v, count(v, g));
+  }
+}
+
+SolvedState::Counts SolvedState::count(const VertexDesc v, const FaceDAG& g)
+{
+  Counts c;
+  if (!in_degree(v, g))
+  {
+    return c;
+  }
+  c.intermediate = out_degree(v, g) > 0;
+  c.unaccumulated =
+      c.intermediate && !boost::get(boost::vertex_acc_stat, g, v);
+  BOOST_FOREACH(auto oe, out_edges(v, g))
+  {
+    c.on_long_path += out_degree(target(oe, g), g) > 0;
+  }
+  return c;
+}
+
+void SolvedState::set(const VertexDesc v, const Counts& c)
+{
+  Counts& old = _counts[v];
+  _intermediate += c.intermediate;
+  _intermediate -= old.intermediate;
+  _unaccumulated += c.unaccumulated;
+  _unaccumulated -= old.unaccumulated;
+  _on_long_path += c.on_long_path;
+  _on_long_path -= old.on_long_path;
+  old = c;
+}
+
+void SolvedState::update(
+    const FaceDAG& g, const TouchedVertices& touched)
+{
+  /* Vertices removed by a rollback do not count anymore. */
+  const size_t n = num_vertices(g);
+  for (size_t v = n; v < _counts.size(); ++v)
+  {
+    set(v, Counts());
+  }
+  _counts.resize(n);
+  _in_region.resize(n, false);
+
+  /* The counts of a vertex depend on its own edges and properties and
+   * on the out-degrees of its successors. */
+  auto mark = [&](const VertexDesc v)
+  {
+    if (!_in_region[v])
+    {
+      _in_region[v] = true;
+      _region.push_back(v);
+    }
+  };
+  for (const VertexDesc v : touched)
+  {
+    if (v >= n)
+    {
+      continue;
+    }
+    mark(v);
+    BOOST_FOREACH(auto ie, in_edges(v, g))
+    {
+      mark(source(ie, g));
+    }
+  }
+  for (const VertexDesc v : _region)
+  {
+    set(v, count(v, g));
+    _in_region[v] = false;
+  }
+  _region.clear();
+}
+
+}  // end namespace admission
@@ -107,7 +107,13 @@ void write_tikz(std::ostream& out, const DAG& g)
   out << "\\end{tikzpicture}";
 }
 
-void write_tikz(std::ostream& out, const FaceDAG& g)
+/**\brief Writes a face DAG of either container type in TikZ.
+ *
+ * @param[inout] out Reference to a std::ostream to which the tikz code is written.
+ * @param[in] g const reference to the face DAG.
+ */
+template<typename Graph>
+void write_face_dag_tikz(std::ostream& out, const Graph& g)
 {
   auto index = boost::get(boost::vertex_index, g);
   auto c_tan = boost::get(boost::vertex_c_tan, g);
@@ -200,6 +206,16 @@ void write_tikz(std::ostream& out, const FaceDAG& g)
   out << "\\end{tikzpicture}";
 }
 
+void write_tikz(std::ostream& out, const BoostFaceDAG& g)
+{
+  write_face_dag_tikz(out, g);
+}
+
+void write_tikz(std::ostream& out, const FlatFaceDAG& g)
+{
+  write_face_dag_tikz(out, g);
+}
+
 void write_tikz(std::ostream& out, const MetaDAG& g)
 {
   auto info = boost::get(boost::vertex_info, g);
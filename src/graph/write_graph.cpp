@@ -36,7 +36,7 @@ void write_graphml(std::ostream& os, admission::DAG& g)
   boost::write_graphml(os, g, dp);
 }
 
-void write_graphml(std::ostream& os, admission::FaceDAG& g)
+void write_graphml(std::ostream& os, admission::BoostFaceDAG& g)
 {
   boost::dynamic_properties dp;
 
@@ -52,6 +52,13 @@ void write_graphml(std::ostream& os, admission::FaceDAG& g)
   boost::write_graphml(os, g, dp);
 }
 
+void write_graphml(std::ostream& os, admission::FlatFaceDAG& g)
+{
+  admission::BoostFaceDAG h;
+  convert_face_dag(g, h);
+  write_graphml(os, h);
+}
+
 }  // end namespace detail
 
 template<typename Graph>
@@ -64,6 +71,7 @@ void write_graphml(std::string path, Graph& g)
 }
 
 template void write_graphml(std::string path, admission::DAG&);
-template void write_graphml(std::string path, admission::FaceDAG&);
+template void write_graphml(std::string path, admission::BoostFaceDAG&);
+template void write_graphml(std::string path, admission::FlatFaceDAG&);
 
 }  // end namespace admission
@@ -0,0 +1,195 @@
+// ******************************** Includes ******************************** //
+
+#include "lower_bounds/lower_bound_portfolio.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <omp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/// States of the bounds of a portfolio and the vertices they missed.
+class PortfolioState : public LowerBound::State
+{
+ public:
+  std::vector<std::unique_ptr<LowerBound::State>> states;
+  std::vector<std::vector<VertexDesc>> pending;
+};
+
+}  // end anonymous namespace
+
+void LowerBoundPortfolio::add(LowerBound* b)
+{
+  auto m = std::make_unique<Member>();
+  m->bound.reset(b);
+  _members.push_back(std::move(m));
+  ++_n_active;
+}
+
+template<typename Eval>
+flop_t LowerBoundPortfolio::run(flop_t cutoff, Eval&& eval) const
+{
+  /* Any valid bound reaches a cutoff of at most 0. */
+  if (cutoff <= 0)
+  {
+    return 0;
+  }
+
+  /* Cheapest bounds first, untried ones in the order of adding them.
+   * The order is rebuilt on every call, as there are few bounds. */
+  thread_local std::vector<std::pair<double, size_t>> order;
+  order.clear();
+  for (size_t i = 0; i < _members.size(); ++i)
+  {
+    const Member& m = *_members[i];
+    if (m.active)
+    {
+      const size_t calls = m.calls;
+      order.emplace_back(calls ? double(m.time_ns) / calls : 0.0, i);
+    }
+  }
+  std::stable_sort(
+      order.begin(), order.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  flop_t lb = 0;
+  for (const auto& o : order)
+  {
+    Member& m = *_members[o.second];
+    const double t = omp_get_wtime();
+    const flop_t v = eval(o.second);
+    m.time_ns += static_cast<uint64_t>((omp_get_wtime() - t) * 1e9);
+    ++m.calls;
+    lb = std::max(lb, v);
+    if (lb >= cutoff)
+    {
+      ++m.cuts;
+      break;
+    }
+    drop_if_unpaid(m);
+  }
+  return lb;
+}
+
+void LowerBoundPortfolio::drop_if_unpaid(Member& m) const
+{
+  if (_drop_after == 0 || m.cuts > 0 || m.calls < _drop_after ||
+      !m.active.exchange(false))
+  {
+    return;
+  }
+  /* Keep at least one bound. */
+  size_t n = _n_active;
+  while (n > 1)
+  {
+    if (_n_active.compare_exchange_weak(n, n - 1))
+    {
+      return;
+    }
+  }
+  m.active = true;
+}
+
+flop_t LowerBoundPortfolio::operator()(const FaceDAG& g) const
+{
+  return evaluate(g, no_cutoff);
+}
+
+flop_t LowerBoundPortfolio::evaluate(const FaceDAG& g, flop_t cutoff) const
+{
+  flop_t lb = run(
+      cutoff,
+      [&](const size_t i) { return _members[i]->bound->evaluate(g, cutoff); });
+  ADM_DEBUG(5) << "LB = " << lb << std::endl;
+  return lb;
+}
+
+std::unique_ptr<LowerBound::State> LowerBoundPortfolio::make_state(
+    const FaceDAG& g) const
+{
+  auto s = std::make_unique<PortfolioState>();
+  s->pending.resize(_members.size());
+  for (const auto& m : _members)
+  {
+    s->states.push_back(m->active ? m->bound->make_state(g) : nullptr);
+  }
+  return s;
+}
+
+flop_t LowerBoundPortfolio::update(
+    State& state, const FaceDAG& g, const TouchedVertices& touched,
+    flop_t cutoff) const
+{
+  PortfolioState& s = static_cast<PortfolioState&>(state);
+
+  /* Bounds catch up with the modifications they missed when they are
+   * evaluated, or start over if they missed too many. */
+  for (size_t i = 0; i < _members.size(); ++i)
+  {
+    if (!s.states[i])
+    {
+      continue;
+    }
+    if (!_members[i]->active)
+    {
+      s.states[i].reset();
+      s.pending[i] = std::vector<VertexDesc>();
+      continue;
+    }
+    s.pending[i].insert(s.pending[i].end(), touched.begin(), touched.end());
+  }
+
+  flop_t lb = run(
+      cutoff,
+      [&](const size_t i)
+      {
+        const LowerBound& b = *_members[i]->bound;
+        if (!s.states[i])
+        {
+          return b.evaluate(g, cutoff);
+        }
+        if (s.pending[i].size() > num_vertices(g))
+        {
+          s.states[i] = b.make_state(g);
+          s.pending[i].clear();
+        }
+        flop_t v;
+        {
+          ArenaScope scope;
+          const TouchedVertices t(s.pending[i].begin(), s.pending[i].end());
+          v = b.update(*s.states[i], g, t, cutoff);
+        }
+        s.pending[i].clear();
+        return v;
+      });
+  ADM_DEBUG(5) << "LB = " << lb << std::endl;
+  return lb;
+}
+
+void LowerBoundPortfolio::write(std::ostream& os) const
+{
+  os << "Lower bounds:";
+  for (const auto& m : _members)
+  {
+    const size_t calls = m->calls;
+    os << "\n\t" << LowerBoundFactory::instance()->tag(m->bound.get())
+       << ": " << calls << " evaluations, " << m->cuts << " cuts, "
+       << std::setprecision(3) << m->time_ns * 1e-9 << "s"
+       << (m->active ? "" : " (dropped)");
+  }
+  os << std::endl;
+}
+
+}  // end namespace admission
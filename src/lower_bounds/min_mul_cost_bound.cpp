@@ -0,0 +1,81 @@
+// ******************************** Includes ******************************** //
+
+#include "lower_bounds/min_mul_cost_bound.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/properties.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stddef.h>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+flop_t MinMulCostBound::operator()(const FaceDAG& g) const
+{
+  constexpr flop_t inf = std::numeric_limits<flop_t>::max();
+  const size_t V = num_vertices(g);
+  auto n = boost::get(boost::edge_size, g);
+
+  std::vector<VertexDesc> order;
+  topological_order(g, order);
+
+  // Smallest in-edge of v and its ancestors...
+  std::vector<flop_t> up(V, inf);
+  for (const VertexDesc v : order)
+  {
+    BOOST_FOREACH(auto ie, in_edges(v, g))
+    {
+      up[v] = std::min({up[v], n[ie], up[source(ie, g)]});
+    }
+  }
+  // ...and smallest out-edge of v and its descendants.
+  std::vector<flop_t> down(V, inf);
+  for (auto it = order.rbegin(); it != order.rend(); ++it)
+  {
+    BOOST_FOREACH(auto oe, out_edges(*it, g))
+    {
+      down[*it] = std::min({down[*it], n[oe], down[target(oe, g)]});
+    }
+  }
+
+  // Cheapest product through every index j, if j must be eliminated.
+  index_t max_index = 0;
+  BOOST_FOREACH(auto e, edges(g))
+  {
+    max_index = std::max(max_index, index(e, g));
+  }
+  std::vector<flop_t> in(max_index + 1, inf);
+  std::vector<flop_t> out(max_index + 1, inf);
+  std::vector<flop_t> size(max_index + 1, 0);
+  BOOST_FOREACH(auto e, edges(g))
+  {
+    const index_t j = index(e, g);
+    in[j] = std::min(in[j], up[source(e, g)]);
+    out[j] = std::min(out[j], down[target(e, g)]);
+    if (in_degree(source(e, g), g) && out_degree(target(e, g), g))
+    {
+      size[j] = n[e];
+    }
+  }
+
+  flop_t min_mul_c = 0;
+  for (index_t j = 0; j <= max_index; ++j)
+  {
+    if (size[j])
+    {
+      min_mul_c += in[j] * size[j] * out[j];
+    }
+  }
+
+  ADM_DEBUG(5) << "LB = " << min_mul_c << std::endl;
+  return min_mul_c;
+}
+
+}  // end namespace admission
@@ -12,6 +12,8 @@
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <stddef.h>
 #include <utility>
 #include <vector>
 
@@ -20,36 +22,109 @@
 namespace admission
 {
 
-flop_t SimpleMinAccCostBound::operator()(const FaceDAG& g) const
+namespace
 {
 
-  flop_t min_acc_c = 0;
-  std::vector<flop_t> uf(num_vertices(g), std::numeric_limits<flop_t>::max());
-  std::vector<flop_t> lf(num_vertices(g), std::numeric_limits<flop_t>::max());
-  std::vector<bool> was_used(num_vertices(g), false);
+constexpr flop_t inf = std::numeric_limits<flop_t>::max();
 
-  auto c_adj = boost::get(boost::vertex_c_adj, g);
-  auto c_tan = boost::get(boost::vertex_c_tan, g);
+/// Cheapest accumulation of v, 0 if it is accumulated or has no model.
+flop_t min_acc_cost(
+    const VertexDesc v, const FaceDAG& g, const std::vector<flop_t>& uf,
+    const std::vector<flop_t>& lf)
+{
+  if (!in_degree(v, g) || !out_degree(v, g) ||
+      boost::get(boost::vertex_acc_stat, g, v) == true ||
+      boost::get(boost::vertex_has_model, g, v) == false)
+  {
+    return 0;
+  }
   auto n = boost::get(boost::edge_size, g);
-  auto Fdot_tilde_exists = boost::get(boost::vertex_has_model, g);
-  auto Fprime_exists = boost::get(boost::vertex_acc_stat, g);
+  const flop_t c_adj = boost::get(boost::vertex_c_adj, g, v);
+  const flop_t c_tan = boost::get(boost::vertex_c_tan, g, v);
+  return std::min(
+      {c_adj * n[*(out_edges(v, g).first)], c_tan * n[*(in_edges(v, g).first)],
+       c_adj * uf[v], c_tan * lf[v]});
+}
 
-  auto ufm = boost::make_iterator_property_map(
-      uf.begin(), boost::get(boost::vertex_index, g));
-  auto lfm = boost::make_iterator_property_map(
-      lf.begin(), boost::get(boost::vertex_index, g));
+/// Incremental evaluation of the SimpleMinAccCostBound.
+class MinAccState : public LowerBound::State
+{
+ public:
+  std::vector<flop_t> uf;
+  std::vector<flop_t> lf;
+  /// Cheapest accumulation of every vertex, summing up to bound.
+  std::vector<flop_t> acc;
+  flop_t bound = 0;
 
-  BOOST_FOREACH(auto e, edges(g))
+  /// Scratch buffers of update(...).
+  std::vector<VertexDesc> work;
+  std::vector<VertexDesc> dirty;
+  std::vector<char> queued;
+  std::vector<char> is_dirty;
+
+  /// Recomputes f[v] = min(v) for v in work and, while the values
+  /// change, for the neighbours next(v), marking them dirty.
+  template<typename Min, typename Next>
+  void propagate(std::vector<flop_t>& f, Min&& min, Next&& next)
   {
-    if (out_degree(target(e, g), g) == 0)
+    for (const VertexDesc v : work)
+    {
+      queued[v] = true;
+    }
+    while (!work.empty())
     {
-      put_extreme(g, e, lf, lower_accessor());
+      const VertexDesc v = work.back();
+      work.pop_back();
+      queued[v] = false;
+      mark_dirty(v);
+      const flop_t m = min(v);
+      if (m == f[v])
+      {
+        continue;
+      }
+      f[v] = m;
+      next(
+          v,
+          [&](const VertexDesc w)
+          {
+            if (!queued[w])
+            {
+              queued[w] = true;
+              work.push_back(w);
+            }
+          });
     }
-    else if (in_degree(source(e, g), g) == 0)
+  }
+
+  void mark_dirty(const VertexDesc v)
+  {
+    if (!is_dirty[v])
     {
-      put_extreme(g, e, uf, upper_accessor());
+      is_dirty[v] = true;
+      dirty.push_back(v);
     }
   }
+};
+
+}  // end anonymous namespace
+
+flop_t SimpleMinAccCostBound::operator()(const FaceDAG& g) const
+{
+
+  flop_t min_acc_c = 0;
+  /* Reuse the buffers of this thread. */
+  thread_local std::vector<VertexDesc> order;
+  thread_local std::vector<flop_t> uf;
+  thread_local std::vector<flop_t> lf;
+  topological_order(g, order);
+  put_extremes(g, order, lf, lower_accessor());
+  put_extremes(g, order, uf, upper_accessor());
+
+  auto c_adj = boost::get(boost::vertex_c_adj, g);
+  auto c_tan = boost::get(boost::vertex_c_tan, g);
+  auto n = boost::get(boost::edge_size, g);
+  auto Fdot_tilde_exists = boost::get(boost::vertex_has_model, g);
+  auto Fprime_exists = boost::get(boost::vertex_acc_stat, g);
 
   BOOST_FOREACH(auto v, vertices(g))
   {
@@ -59,8 +134,8 @@ flop_t SimpleMinAccCostBound::operator()(const FaceDAG& g) const
     {
       min_acc_c += std::min(
           {c_adj[v] * n[*(out_edges(v, g).first)],
-           c_tan[v] * n[*(in_edges(v, g).first)], c_adj[v] * ufm[v],
-           c_tan[v] * lfm[v]});
+           c_tan[v] * n[*(in_edges(v, g).first)], c_adj[v] * uf[v],
+           c_tan[v] * lf[v]});
     }
   }
 
@@ -68,4 +143,96 @@ flop_t SimpleMinAccCostBound::operator()(const FaceDAG& g) const
   return min_acc_c;
 }
 
+std::unique_ptr<LowerBound::State> SimpleMinAccCostBound::make_state(
+    const FaceDAG& g) const
+{
+  auto s = std::make_unique<MinAccState>();
+  const size_t V = num_vertices(g);
+  s->uf.assign(V, inf);
+  s->lf.assign(V, inf);
+  s->acc.assign(V, 0);
+  s->queued.assign(V, false);
+  s->is_dirty.assign(V, false);
+
+  std::vector<VertexDesc> order;
+  topological_order(g, order);
+  put_extremes(g, order, s->lf, lower_accessor());
+  put_extremes(g, order, s->uf, upper_accessor());
+  BOOST_FOREACH(auto v, vertices(g))
+  {
+    s->acc[v] = min_acc_cost(v, g, s->uf, s->lf);
+    s->bound += s->acc[v];
+  }
+  return s;
+}
+
+flop_t SimpleMinAccCostBound::update(
+    State& state, const FaceDAG& g, const TouchedVertices& touched,
+    flop_t) const
+{
+  MinAccState& s = static_cast<MinAccState&>(state);
+
+  /* Vertices removed by a rollback do not count anymore. */
+  const size_t V = num_vertices(g);
+  for (size_t v = V; v < s.acc.size(); ++v)
+  {
+    s.bound -= s.acc[v];
+  }
+  s.uf.resize(V, inf);
+  s.lf.resize(V, inf);
+  s.acc.resize(V, 0);
+  s.queued.resize(V, false);
+  s.is_dirty.resize(V, false);
+
+  // lf depends on the predecessors...
+  for (const VertexDesc v : touched)
+  {
+    if (v < V)
+    {
+      s.work.push_back(v);
+    }
+  }
+  s.propagate(
+      s.lf, [&](const VertexDesc v)
+      { return extreme_at(g, v, s.lf, lower_accessor()); },
+      [&](const VertexDesc v, auto&& push)
+      {
+        BOOST_FOREACH(auto oe, out_edges(v, g))
+        {
+          push(target(oe, g));
+        }
+      });
+
+  // ...and uf on the successors.
+  for (const VertexDesc v : touched)
+  {
+    if (v < V)
+    {
+      s.work.push_back(v);
+    }
+  }
+  s.propagate(
+      s.uf, [&](const VertexDesc v)
+      { return extreme_at(g, v, s.uf, upper_accessor()); },
+      [&](const VertexDesc v, auto&& push)
+      {
+        BOOST_FOREACH(auto ie, in_edges(v, g))
+        {
+          push(source(ie, g));
+        }
+      });
+
+  for (const VertexDesc v : s.dirty)
+  {
+    const flop_t c = min_acc_cost(v, g, s.uf, s.lf);
+    s.bound += c - s.acc[v];
+    s.acc[v] = c;
+    s.is_dirty[v] = false;
+  }
+  s.dirty.clear();
+
+  ADM_DEBUG(5) << "LB = " << s.bound << std::endl;
+  return s.bound;
+}
+
 }  // end namespace admission
@@ -0,0 +1,75 @@
+// ******************************** Includes ******************************** //
+
+#include "misc/heap_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stddef.h>
+
+// **************************** Source contents ***************************** //
+
+#if ADM_COUNT_ALLOCATIONS
+
+namespace
+{
+
+std::atomic<admission::count_t> n_allocations{0};
+
+void* counted_malloc(size_t bytes)
+{
+  n_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(bytes ? bytes : 1))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+}  // end anonymous namespace
+
+void* operator new(size_t bytes)
+{
+  return counted_malloc(bytes);
+}
+
+void* operator new[](size_t bytes)
+{
+  return counted_malloc(bytes);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+#endif  // ADM_COUNT_ALLOCATIONS
+
+namespace admission
+{
+
+count_t heap_allocations()
+{
+#if ADM_COUNT_ALLOCATIONS
+  return n_allocations.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif  // ADM_COUNT_ALLOCATIONS
+}
+
+}  // end namespace admission
@@ -25,12 +25,12 @@ namespace admission
  * @param[in] from VertexDesc of the source vertex
  * @param[in] to   VertexDesc of the target vertex
  * @returns a list of paths between from and to. Each path is a list of the
- *          EdgeDesc of the edges of the path.
+ *          DAGEdgeDesc of the edges of the path.
  */
-std::list<std::list<EdgeDesc>> path_from_to(
+std::list<std::list<DAGEdgeDesc>> path_from_to(
     const DAG& g, VertexDesc from, VertexDesc to)
 {
-  std::list<std::list<EdgeDesc>> sp;
+  std::list<std::list<DAGEdgeDesc>> sp;
 
   BOOST_FOREACH(auto ed, out_edges(from, g))
   {
@@ -43,7 +43,7 @@ std::list<std::list<EdgeDesc>> path_from_to(
     }
     else
     {
-      std::list<std::list<EdgeDesc>> lps = path_from_to(g, next, to);
+      std::list<std::list<DAGEdgeDesc>> lps = path_from_to(g, next, to);
       if (!lps.empty())
       {
         for (auto& p : lps)
@@ -28,38 +28,90 @@ std::pair<bool, VertexDesc> has_merge_candidate(
     return std::make_pair(false, VertexDesc());
   }
 
-  // Iterate over all successors (jk) of (ij) ...
-  BOOST_FOREACH(auto oe, out_edges(ij, g))
+  // Iterate over all predecessors (hj) of the successor (jk) of (ij)
+  // with the fewest predecessors. Any vertex with the same successors
+  // as (ij) is among them.
+  if (!out_degree(ij, g))
   {
-    VertexDesc jk = target(oe, g);
+    return std::make_pair(false, VertexDesc());
+  }
+  VertexDesc jk = rarest_neighbor<FaceDAG, upper_accessor>(g, ij);
+  BOOST_FOREACH(auto ie, in_edges(jk, g))
+  {
+    VertexDesc hj = source(ie, g);
+    if (hj == ij)
+    {
+      continue;
+    }
 
-    // ... and over all predecessors (hj) of all successors (jk)
-    BOOST_FOREACH(auto ie, in_edges(jk, g))
+    // Check if succ. set and pred. sets are identical
+    // (1.) Condition for generation of fill-in.
+    // P(i,*,k) = P(i,*,j) && S(i,*,k) = S(j,*,k) && F'(j,*,k) != \emptyset
+    if (same_successors(g, hj, ij) && same_predecessors(g, hj, ij) &&
+        Jprime_exists[hj])
     {
-      VertexDesc hj = source(ie, g);
-      if (hj == ij)
+      return std::make_pair(true, hj);
+    }
+  }
+  return std::make_pair(false, VertexDesc());
+}
+
+OpSequence get_mergeable_preacc(const VertexDesc ij, const FaceDAG& g)
+{
+  auto n = boost::get(boost::edge_size, g);
+
+  auto&& [has_candidate, iprimejprime] = has_merge_candidate(ij, g);
+  if (has_candidate == false)
+  {
+    return OpSequence::make_max();
+  }
+  auto i = *(in_edges(ij, g).first);
+  auto j = *(out_edges(ij, g).first);
+
+  // Find the cheapest preaccumulation...
+  auto acc_s = cheapest_preacc(ij, g);
+
+  // ...and if its in TAN direction check the predecessors.
+  if ((acc_s.front())._dir == TAN)
+  {
+    flop_t in_sum = 0;
+    BOOST_FOREACH(auto e, in_edges(ij, g))
+    {
+      if (in_degree(source(e, g), g))
       {
-        continue;
+        in_sum += n[*(in_edges(source(e, g), g).first)];
       }
-
-      // Check if succ. set and pred. sets are identical
-      // (1.) Condition for generation of fill-in.
-      // P(i,*,k) = P(i,*,j) && S(i,*,k) = S(j,*,k) && F'(j,*,k) != \emptyset
-      if (same_predecessors(g, hj, ij) && same_successors(g, hj, ij) &&
-          Jprime_exists[hj])
+    }
+    // If we found a suited preaccumulation, we are done.
+    if (n[i] < in_sum)
+    {
+      return acc_s;
+    }
+  }
+  // ... if its in ADJ direction check the succcessors.
+  else
+  {
+    flop_t out_sum = 0;
+    BOOST_FOREACH(auto e, out_edges(ij, g))
+    {
+      if (out_degree(target(e, g), g))
       {
-        return std::make_pair(true, hj);
+        out_sum += n[*(out_edges(target(e, g), g).first)];
       }
     }
+    // If we found a suited preaccumulation, we are done.
+    if (n[j] < out_sum)
+    {
+      return acc_s;
+    }
   }
-  return std::make_pair(false, VertexDesc());
+  return OpSequence::make_max();
 }
 
 std::pair<OpSequence, VertexDesc> get_mergeable_vertex_on_any_graph(
     const admission::FaceDAG& g)
 {
   std::pair<OpSequence, VertexDesc> res(OpSequence::make_max(), VertexDesc());
-  auto n = boost::get(boost::edge_size, g);
 
   // Check if there are vertices that are mergeable by preaccumulation
   // cheaper than propagating their neighboring Jacobians through them.
@@ -68,49 +120,10 @@ std::pair<OpSequence, VertexDesc> get_mergeable_vertex_on_any_graph(
   #pragma omp parallel for
   for (int ij = 0; ij < V; ++ij)
   {
-    auto&& [has_candidate, iprimejprime] = has_merge_candidate(ij, g);
-    if (has_candidate == true)
+    auto acc_s = get_mergeable_preacc(ij, g);
+    if (acc_s.cost() < OpSequence::max)
     {
-      auto i = *(in_edges(ij, g).first);
-      auto j = *(out_edges(ij, g).first);
-
-      // Find the cheapest preaccumulation...
-      auto acc_s = cheapest_preacc(ij, g);
-
-      // ...and if its in TAN direction check the predecessors.
-      if ((acc_s.front())._dir == TAN)
-      {
-        flop_t in_sum = 0;
-        BOOST_FOREACH(auto e, in_edges(ij, g))
-        {
-          if (in_degree(source(e, g), g))
-          {
-            in_sum += n[*(in_edges(source(e, g), g).first)];
-          }
-        }
-        // If we found a suited preaccumulation, we are done.
-        if (n[i] < in_sum)
-        {
-          res = std::make_pair(acc_s, ij);
-        }
-      }
-      // ... if its in ADJ direction check the succcessors.
-      else
-      {
-        flop_t out_sum = 0;
-        BOOST_FOREACH(auto e, out_edges(ij, g))
-        {
-          if (out_degree(target(e, g), g))
-          {
-            out_sum += n[*(out_edges(target(e, g), g).first)];
-          }
-        }
-        // If we found a suited preaccumulation, we are done.
-        if (n[j] < out_sum)
-        {
-          res = std::make_pair(acc_s, ij);
-        }
-      }
+      res = std::make_pair(acc_s, ij);
     }
   }
   return res;
@@ -126,11 +139,13 @@ OpSequence get_cheapest_elim(const EdgeDesc ijk, const FaceDAG& g)
   OpSequence opt = OpSequence::make_max();
 
   // A Lambda for simplifying the update of the optimum.
-  auto update = [&](const OpSequence& new_elim)
+  // The parts are only concatenated if they improve it.
+  auto update = [&](const auto&... parts)
   {
-    if (new_elim.cost() < opt.cost())
+    if ((parts.cost() + ... + 0) < opt.cost())
     {
-      opt = new_elim;
+      opt = OpSequence::make_empty();
+      ((opt += parts), ...);
     }
   };
 
@@ -168,10 +183,10 @@ OpSequence get_cheapest_elim(const EdgeDesc ijk, const FaceDAG& g)
   //  - propagate \f$F'_{ij}\f$ through \f$\dot F_{jk}\f$ in TAN mode.
   else if ((acc_stat[ij] == true) && (acc_stat[jk] == false))
   {
-    update(jk_acc + mul_s);
+    update(jk_acc, mul_s);
     if (hm[ij])
     {
-      update(jk_acc + adj_s);
+      update(jk_acc, adj_s);
     }
     update(tan_s);
   }
@@ -184,10 +199,10 @@ OpSequence get_cheapest_elim(const EdgeDesc ijk, const FaceDAG& g)
   //  - propagate \f$F'_{jk}\f$ through \f$\bar F_{ij}\f$ in ADJ mode.
   else if ((acc_stat[ij] == false) && (acc_stat[jk] == true))
   {
-    update(ij_acc + mul_s);
+    update(ij_acc, mul_s);
     if (hm[jk])
     {
-      update(ij_acc + tan_s);
+      update(ij_acc, tan_s);
     }
     update(adj_s);
   }
@@ -199,9 +214,9 @@ OpSequence get_cheapest_elim(const EdgeDesc ijk, const FaceDAG& g)
   //  - accumulate \f$F'_{jk}\f$ and propagate through \f$\bar F_{ij}\f$ in ADJ mode
   else
   {
-    update(ij_acc + jk_acc + mul_s);
-    update(ij_acc + tan_s);
-    update(jk_acc + adj_s);
+    update(ij_acc, jk_acc, mul_s);
+    update(ij_acc, tan_s);
+    update(jk_acc, adj_s);
   }
   return opt;
 }
@@ -0,0 +1,129 @@
+// ******************************** Includes ******************************** //
+
+#include "operations/footprint.hpp"
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <stddef.h>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/**\brief Appends x, its successors and their predecessors to fp.
+ *
+ * Operations on x look at the predecessors of x only as a set, and search
+ * absorption and merge candidates among the predecessors of its successors.
+ */
+void add_neighbourhood(
+    const VertexDesc x, const FaceDAG& g, std::vector<VertexDesc>& fp)
+{
+  fp.push_back(x);
+  BOOST_FOREACH(auto oe, out_edges(x, g))
+  {
+    const VertexDesc s = target(oe, g);
+    fp.push_back(s);
+    BOOST_FOREACH(auto ie, in_edges(s, g))
+    {
+      fp.push_back(source(ie, g));
+    }
+  }
+}
+
+/// Sorts v and removes duplicates.
+void make_set(std::vector<VertexDesc>& v)
+{
+  std::sort(v.begin(), v.end());
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+/// True if the sorted sets a and b are disjoint.
+bool disjoint(const std::vector<VertexDesc>& a, const std::vector<VertexDesc>& b)
+{
+  auto ia = a.begin();
+  auto ib = b.begin();
+  while (ia != a.end() && ib != b.end())
+  {
+    if (*ia < *ib)
+    {
+      ++ia;
+    }
+    else if (*ib < *ia)
+    {
+      ++ib;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // end anonymous namespace
+
+Footprint footprint(const OpSequence& s, FaceDAG& g, Trail& trail)
+{
+  Footprint fp;
+  for (const auto& opc : s)
+  {
+    add_neighbourhood(opc._ij, g, fp.reads);
+    if (is_elimination(opc))
+    {
+      add_neighbourhood(opc._jk, g, fp.reads);
+    }
+  }
+
+  const size_t n = num_vertices(g);
+  const Trail::Mark mark = trail.mark();
+  s.apply(g, &trail);
+  trail.touched(mark, [&](const VertexDesc v)
+  {
+    if (v < n)
+    {
+      fp.writes.push_back(v);
+    }
+  });
+  trail.rollback(g, mark);
+
+  fp.reads.insert(fp.reads.end(), fp.writes.begin(), fp.writes.end());
+  make_set(fp.reads);
+  make_set(fp.writes);
+  return fp;
+}
+
+bool independent(const Footprint& a, const Footprint& b)
+{
+  return disjoint(a.writes, b.reads) && disjoint(b.writes, a.reads);
+}
+
+bool same_operations(const OpSequence& a, const OpSequence& b)
+{
+  if (a.size() != b.size() || a.cost() != b.cost())
+  {
+    return false;
+  }
+  auto ib = b.begin();
+  for (const auto& oa : a)
+  {
+    const OpCont& ob = *(ib++);
+    const bool eli = is_elimination(oa);
+    if (eli != is_elimination(ob) || oa._dir != ob._dir ||
+        oa._cost != ob._cost)
+    {
+      return false;
+    }
+    if (oa._ij != ob._ij || (eli && oa._jk != ob._jk))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // end namespace admission
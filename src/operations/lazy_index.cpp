@@ -0,0 +1,74 @@
+// ******************************** Includes ******************************** //
+
+#include "operations/lazy_index.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+LazyIndex::LazyIndex(const FaceDAG& g)
+{
+  BOOST_FOREACH(auto v, boost::vertices(g))
+  {
+    add(v, g);
+  }
+}
+
+void LazyIndex::add(const VertexDesc v, const FaceDAG& g)
+{
+  if (in_degree(v, g) && out_degree(v, g))
+  {
+    auto [i, j] = index_pair(v, g);
+    _buckets[key(i, j)].push_back(v);
+  }
+}
+
+const std::vector<VertexDesc>& LazyIndex::vertices(
+    const index_t i, const index_t j, const FaceDAG& g)
+{
+  auto it = _buckets.find(key(i, j));
+  if (it == _buckets.end())
+  {
+    return _none;
+  }
+
+  /* Drop vertices that were added repeatedly or are not
+   * intermediate anymore. */
+  std::vector<VertexDesc>& b = it->second;
+  std::sort(b.begin(), b.end());
+  b.erase(std::unique(b.begin(), b.end()), b.end());
+  b.erase(
+      std::remove_if(
+          b.begin(), b.end(),
+          [&](const VertexDesc v)
+          {
+            return v >= num_vertices(g) || !in_degree(v, g) ||
+                   !out_degree(v, g) ||
+                   index_pair(v, g) != std::make_tuple(i, j);
+          }),
+      b.end());
+  return b;
+}
+
+void LazyIndex::update(
+    const FaceDAG& g, const Trail& trail, const Trail::Mark m)
+{
+  trail.touched(
+      m,
+      [&](const VertexDesc v)
+      {
+        if (v < num_vertices(g))
+        {
+          add(v, g);
+        }
+      });
+}
+
+}  // end namespace admission
@@ -3,11 +3,15 @@
 #include "operations/op_sequence.hpp"
 
 #include "graph/tikz.hpp"
+#include "graph/trail.hpp"
+#include "operations/find_eliminations.hpp"
+#include "operations/lazy_index.hpp"
 #include "elimination_algorithm.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
+#include <algorithm>
 #include <assert.h>
 #include <stddef.h>
 #include <stdexcept>
@@ -17,154 +21,290 @@
 namespace admission
 {
 
-/**\brief Write info about this AccOp to a stream.
- *
- * @param[inout] o Reference to a std::ostream.
- * @param[in] opc Pointer to the OpCont.
- */
-std::ostream& AccOp::write(std::ostream& o, const OpCont* opc) const
+namespace
 {
-  o << "PRE " << dir_to_s(opc->_dir) << " " << opc->_i << " " << opc->_j << " "
-    << opc->_cost << std::endl;
-  return o;
-}
 
-/**\brief Apply this AccOp to a FaceDAG.
+/**\brief Accumulates the vertex ij.
  *
+ * @param[in] ij VertexDesc of the vertex.
  * @param[inout] g Reference to the FaceDAG.
- * @param[in]  opc Pointer to the OpCont.
- * @returns bool if successful.
+ * @param[in] opc The OpCont, for error messages.
+ * @param[inout] trail Records all modifications of g if not nullptr.
+ * @returns bool true if successful.
  */
-bool AccOp::apply(FaceDAG& g, const OpCont* opc) const
+bool apply_acc(const VertexDesc ij, FaceDAG& g, const OpCont& opc, Trail* trail)
 {
   auto a = boost::get(boost::vertex_acc_stat, g);
   auto m = boost::get(boost::vertex_has_model, g);
 
-  if (a[opc->_ij] == false && m[opc->_ij] == true)
+  if (a[ij] == false && m[ij] == true)
   {
-    Preaccumulate(opc->_ij, g);
+    Preaccumulate(ij, g, false, trail);
     return true;
   }
   throw std::runtime_error(
-      "The Jacobian F'_(" + opc->where() +
+      "The Jacobian F'_(" + opc.where() +
       ") is already preaccumulated or there is no model.");
 }
 
-/* \brief Applies the lazy accumulation operation by searching
- *        the DAG g for the correct vertex.
+/* \brief Finds the vertex a lazy accumulation operation accumulates by
+ *        searching the DAG g or the index.
  *
- * @param[inout] g Reference to the DAG that is modified.
- * @param[in]  opc Pointer to the OpCont.
+ * @param[in] g Reference to the DAG.
+ * @param[in] opc The OpCont.
+ * @param[in] index Vertices of g by index pair if not nullptr.
+ * @returns The vertex.
+ * @throws std::runtime_error if there is no such vertex.
  */
-bool LazyAccOp::apply(FaceDAG& g, const OpCont* opc) const
+VertexDesc find_lazy_acc(const FaceDAG& g, const OpCont& opc, LazyIndex* index)
 {
   auto a = boost::get(boost::vertex_acc_stat, g);
   auto m = boost::get(boost::vertex_has_model, g);
 
-  BOOST_FOREACH(auto v, vertices(g))
+  if (index)
   {
-    if (in_degree(v, g) && out_degree(v, g) &&
-        std::tie(opc->_i, opc->_j) == index_pair(v, g) && a[v] == false &&
-        m[v] == true)
+    for (const VertexDesc v : index->vertices(opc._i, opc._j, g))
     {
-      Preaccumulate(v, g);
-      return true;
+      if (a[v] == false && m[v] == true)
+      {
+        return v;
+      }
+    }
+  }
+  else
+  {
+    BOOST_FOREACH(auto v, vertices(g))
+    {
+      if (in_degree(v, g) && out_degree(v, g) &&
+          std::tie(opc._i, opc._j) == index_pair(v, g) && a[v] == false &&
+          m[v] == true)
+      {
+        return v;
+      }
     }
   }
   throw std::runtime_error(
-      "No elemental Jacobian F'_(" + opc->where() +
+      "No elemental Jacobian F'_(" + opc.where() +
       ") to accumulate was found.");
 }
 
-/**\brief Stringify the indices _i and _j of an OpCont.
+/* \brief Applies the lazy accumulation operation by searching
+ *        the DAG g or the index for the correct vertex.
  *
- * @param opc Pointer to the OpCont.
- * @returns std::string (i, j)
+ * @param[inout] g Reference to the DAG that is modified.
+ * @param[in] opc The OpCont.
+ * @param[inout] trail Records all modifications of g if not nullptr.
+ * @param[inout] index Vertices of g by index pair if not nullptr.
  */
-const std::string AccOp::where(const OpCont* opc) const
+bool apply_lazy_acc(
+    FaceDAG& g, const OpCont& opc, Trail* trail, LazyIndex* index)
 {
-  return std::to_string(opc->_i) + ", " + std::to_string(opc->_j);
+  Preaccumulate(find_lazy_acc(g, opc, index), g, false, trail);
+  return true;
 }
 
-/**\brief Write info about this AccOp to a stream.
+/* \brief Finds the edge a lazy elimination operation eliminates by
+ *        searching the DAG g or the index.
  *
- * @param[inout] o Reference to a std::ostream.
- * @param[in]  opc Pointer to the OpCont.
- * @returns std::ostream& o.
+ * @param[in] g Reference to the DAG.
+ * @param[in] opc The OpCont.
+ * @param[in] index Vertices of g by index pair if not nullptr.
+ * @returns The edge.
+ * @throws std::runtime_error if there is no such edge.
  */
-std::ostream& EliOp::write(std::ostream& o, const OpCont* opc) const
+EdgeDesc find_lazy_eli(const FaceDAG& g, const OpCont& opc, LazyIndex* index)
 {
-  o << "ELI " << dir_to_s(opc->_dir) << " " << opc->_i << " " << opc->_j << " "
-    << opc->_k << " " << opc->_cost << std::endl;
-  return o;
+  auto a = boost::get(boost::vertex_acc_stat, g);
+  auto m = boost::get(boost::vertex_has_model, g);
+  const dir_t dir = opc._dir;
+
+  // The Jacobians required by the direction of the operation exist.
+  auto applicable = [&](const EdgeDesc e)
+  {
+    return (a[source(e, g)] || (dir == ADJ)) &&
+           (a[target(e, g)] || (dir == TAN)) &&
+           (m[source(e, g)] || !(dir == ADJ)) &&
+           (m[target(e, g)] || !(dir == TAN));
+  };
+
+  if (index)
+  {
+    // All out-edges of (i,j) have index j.
+    for (const VertexDesc ij : index->vertices(opc._i, opc._j, g))
+    {
+      BOOST_FOREACH(auto e, out_edges(ij, g))
+      {
+        const VertexDesc jk = target(e, g);
+        if (out_degree(jk, g) &&
+            admission::index(*(out_edges(jk, g).first), g) == opc._k &&
+            applicable(e))
+        {
+          return e;
+        }
+      }
+    }
+  }
+  else
+  {
+    BOOST_FOREACH(auto e, edges(g))
+    {
+      if (in_degree(source(e, g), g) && out_degree(target(e, g), g) &&
+          (index_triple(e, g) == std::tie(opc._i, opc._j, opc._k)) &&
+          applicable(e))
+      {
+        return e;
+      }
+    }
+  }
+  throw std::runtime_error(
+      "No vertices with index triple (" + opc.where() +
+      ") were found for operation " + dir_to_s(dir));
 }
 
-/**\brief Apply this EliOp to a FaceDAG.
+/* \brief Applies the lazy elimination operation by searching
+ *        the DAG g or the index for the correct edge.
  *
- * @param[inout] g Reference to the FaceDAG.
- * @param[in]  opc Pointer to the OpCont.
- * @returns bool if successful.
+ * @param[inout] g Reference to the DAG that is modified.
+ * @param[in] opc The OpCont.
+ * @param[inout] trail Records all modifications of g if not nullptr.
+ * @param[inout] index Vertices of g by index pair if not nullptr.
  */
-bool EliOp::apply(FaceDAG& g, const OpCont* opc) const
+bool apply_lazy_eli(
+    FaceDAG& g, const OpCont& opc, Trail* trail, LazyIndex* index)
 {
-  admission::EliminateEdge(opc->_ijk, g);
+  admission::EliminateEdge(find_lazy_eli(g, opc, index), g, trail);
   return true;
 }
 
-bool LazyEliOp::apply(FaceDAG& g, const OpCont* opc) const
+/// True if a and b are the same operation on the same vertices.
+bool same_op(const OpCont& a, const OpCont& b)
 {
-  auto a = boost::get(boost::vertex_acc_stat, g);
-  auto m = boost::get(boost::vertex_has_model, g);
+  if (a._kind != b._kind || a._dir != b._dir || a._cost != b._cost)
+  {
+    return false;
+  }
+  switch (a._kind)
+  {
+    case ACC_OP:
+    {
+      return a._ij == b._ij;
+    }
+    case ELI_OP:
+    {
+      return a._ij == b._ij && a._jk == b._jk;
+    }
+    case LAZY_ACC_OP:
+    {
+      return a._i == b._i && a._j == b._j;
+    }
+    case LAZY_ELI_OP:
+    {
+      return a._i == b._i && a._j == b._j && a._k == b._k;
+    }
+  }
+  return false;
+}
+
+}  // end anonymous namespace
+
+/**\brief Write info about this operation to a stream.
+ *
+ * @param[inout] o Reference to a std::ostream.
+ * @returns std::ostream& o.
+ */
+std::ostream& OpCont::write(std::ostream& o) const
+{
+  if (is_elimination(*this))
+  {
+    o << "ELI " << dir_to_s(_dir) << " " << _i << " " << _j << " " << _k
+      << " " << _cost << std::endl;
+  }
+  else
+  {
+    o << "PRE " << dir_to_s(_dir) << " " << _i << " " << _j << " " << _cost
+      << std::endl;
+  }
+  return o;
+}
 
-  BOOST_FOREACH(auto e, edges(g))
+/**\brief Apply this operation to a FaceDAG.
+ *
+ * @param[inout] g Reference to the FaceDAG.
+ * @param[inout] trail Records all modifications of g if not nullptr.
+ * @param[inout] index Vertices of g by index pair if not nullptr.
+ * @returns bool true if successful.
+ */
+bool OpCont::apply(FaceDAG& g, Trail* trail, LazyIndex* index) const
+{
+  switch (_kind)
   {
-    if (in_degree(source(e, g), g) && out_degree(target(e, g), g) &&
-        (index_triple(e, g) == std::tie(opc->_i, opc->_j, opc->_k)) &&
-        (a[source(e, g)] || (opc->_dir == ADJ)) &&
-        (a[target(e, g)] || (opc->_dir == TAN)) &&
-        (m[source(e, g)] || !(opc->_dir == ADJ)) &&
-        (m[target(e, g)] || !(opc->_dir == TAN)))
+    case ACC_OP:
+    {
+      return apply_acc(_ij, g, *this, trail);
+    }
+    case ELI_OP:
     {
-      admission::EliminateEdge(e, g);
+      admission::EliminateEdge(_ij, _jk, g, trail);
       return true;
     }
+    case LAZY_ACC_OP:
+    {
+      return apply_lazy_acc(g, *this, trail, index);
+    }
+    case LAZY_ELI_OP:
+    {
+      return apply_lazy_eli(g, *this, trail, index);
+    }
   }
-  throw std::runtime_error(
-      "No vertices with index triple (" + opc->where() +
-      ") were found for operation " + dir_to_s(opc->_dir));
+  return false;
 }
 
-/**\brief Stringify _i _j _k form the OpCont to i, j, k.
+/**\brief Stringify the indices of an OpCont.
  *
- * @param[in] opc Pointer to the OpCont.
- * @returns std::string (i, j, k)
+ * @returns std::string "i, j" or "i, j, k"
  */
-const std::string EliOp::where(const OpCont* opc) const
+const std::string OpCont::where() const
 {
-  return std::to_string(opc->_i) + ", " + std::to_string(opc->_j) + ", " +
-         std::to_string(opc->_k);
+  if (is_elimination(*this))
+  {
+    return std::to_string(_i) + ", " + std::to_string(_j) + ", " +
+           std::to_string(_k);
+  }
+  return std::to_string(_i) + ", " + std::to_string(_j);
 }
 
 /**\brief Read an OpSeqeunce from a stream.
  */
 void read_sequence(std::istream&& ist, OpSequence& els)
 {
-  static std::string action;
-  static std::string d;
-  static flop_t c;
-  static index_t i, j, k;
+  std::string action;
+  std::string d;
+  flop_t c;
+  index_t i, j, k;
 
-  ist >> action;
-  while (!ist.eof())
+  /* A failed extraction leaves the stream failed, so every operation
+   * is checked as a whole once it was read. */
+  auto check = [&]()
+  {
+    if (!ist)
+    {
+      throw std::runtime_error(
+          "Operation \"" + action + "\" is incomplete or malformed!");
+    }
+  };
+
+  while (ist >> action)
   {
     if (action == "PRE")
     {
       ist >> d >> i >> j >> c;
+      check();
       els += {make_acc_op(i, j, c, s_to_dir(d))};
     }
     else if (action == "ELI")
     {
       ist >> d >> i >> j >> k >> c;
+      check();
       els += {make_eli_op(i, j, k, c, s_to_dir(d))};
     }
     else
@@ -172,8 +312,30 @@ void read_sequence(std::istream&& ist, OpSequence& els)
       throw std::runtime_error(
           "Selector \"" + action + "\" is neither \"ELI\" nor \"PRE\"!");
     }
-    ist >> action;
   }
+  if (ist.bad())
+  {
+    throw std::runtime_error("Reading the sequence failed!");
+  }
+}
+
+bool OpSequence::starts_with(const OpSequence& prefix) const
+{
+  return prefix.size() <= size() &&
+         std::equal(
+             prefix._sequence.begin(), prefix._sequence.end(),
+             _sequence.begin(), same_op);
+}
+
+bool OpSequence::remove_prefix(const OpSequence& prefix)
+{
+  if (!starts_with(prefix))
+  {
+    return false;
+  }
+  _sequence.erase(_sequence.begin(), _sequence.begin() + prefix.size());
+  _cost -= prefix._cost;
+  return true;
 }
 
 /**\brief Writes the elimination Sequence to a stream.
@@ -208,20 +370,98 @@ FaceDAG& OpSequence::verbose_apply(FaceDAG& g, std::string path) const
   return g;
 }
 
-/**\brief Applies the stored sequence to g and prints the results into files.
+/**\brief Applies the stored sequence to g.
  */
-FaceDAG& OpSequence::apply(FaceDAG& g) const
+FaceDAG& OpSequence::apply(FaceDAG& g, Trail* trail) const
 {
   for (auto& e : _sequence)
   {
 #ifndef NDEBUG
-    auto success = e.apply(g);
+    auto success = e.apply(g, trail);
     assert(success && "Failed to apply an elimination!");
 #else
-    e.apply(g);
+    e.apply(g, trail);
+#endif
+  }
+  return g;
+}
+
+/**\brief Applies the stored sequence to g, finding the vertices
+ *        of lazy operations in a LazyIndex of g.
+ */
+FaceDAG& OpSequence::indexed_apply(FaceDAG& g) const
+{
+  LazyIndex index(g);
+  Trail trail;
+  for (auto& e : _sequence)
+  {
+    const Trail::Mark m = trail.mark();
+#ifndef NDEBUG
+    auto success = e.apply(g, &trail, &index);
+    assert(success && "Failed to apply an elimination!");
+#else
+    e.apply(g, &trail, &index);
 #endif
+    index.update(g, trail, m);
+    trail.forget(m);
   }
   return g;
 }
 
+/**\brief Applies the stored sequence to g like indexed_apply(...) and
+ *        recomputes the cost of every operation on g.
+ */
+OpSequence OpSequence::replay(FaceDAG& g) const
+{
+  auto n = boost::get(boost::edge_size, g);
+  auto c_tan = boost::get(boost::vertex_c_tan, g);
+  auto c_adj = boost::get(boost::vertex_c_adj, g);
+
+  LazyIndex index(g);
+  Trail trail;
+  OpSequence res = make_empty();
+  for (auto& e : _sequence)
+  {
+    OpSequence op = make_empty();
+    if (is_elimination(e))
+    {
+      EdgeDesc ijk;
+      if (e._kind == ELI_OP)
+      {
+        bool found;
+        std::tie(ijk, found) = boost::edge(e._ij, e._jk, g);
+        if (!found)
+        {
+          throw std::runtime_error(
+              "No edge to eliminate for operation " + dir_to_s(e._dir) +
+              " (" + e.where() + ").");
+        }
+      }
+      else
+      {
+        ijk = find_lazy_eli(g, e, &index);
+      }
+      op = (e._dir == TAN) ? tan_prop(ijk, g) :
+           (e._dir == ADJ) ? adj_prop(ijk, g) :
+                             mul(ijk, g);
+    }
+    else
+    {
+      const VertexDesc ij =
+          (e._kind == ACC_OP) ? e._ij : find_lazy_acc(g, e, &index);
+      const flop_t c =
+          (e._dir == TAN) ? n[*(in_edges(ij, g).first)] * c_tan[ij] :
+                            n[*(out_edges(ij, g).first)] * c_adj[ij];
+      op = {make_acc_op(ij, g, c, e._dir)};
+    }
+
+    const Trail::Mark m = trail.mark();
+    op.apply(g, &trail);
+    index.update(g, trail, m);
+    trail.forget(m);
+    res += std::move(op);
+  }
+  return res;
+}
+
 }  // end namespace admission
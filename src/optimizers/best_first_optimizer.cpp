@@ -0,0 +1,270 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/best_first_optimizer.hpp"
+
+#include "graph/DAG.hpp"
+#include "graph/hash.hpp"
+#include "graph/trail.hpp"
+#include "lower_bounds/lower_bound.hpp"
+#include "misc/arena.hpp"
+#include "misc/heap_counter.hpp"
+#include "misc/periodic_thread.hpp"
+#include "optimizers/optimizer_stats.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <omp.h>
+#include <queue>
+#include <stddef.h>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/// Entry of the open list.
+struct Open
+{
+  /// Cost so far plus lower bound.
+  flop_t f;
+  /// Cost so far.
+  flop_t cost;
+  /// Index of the node.
+  size_t n;
+
+  /// Smallest f first. On ties, prefer nodes closer to a leaf.
+  bool operator<(const Open& o) const
+  {
+    return f > o.f || (f == o.f && cost < o.cost);
+  }
+};
+
+/// Hashes a FaceDAGHash for std::unordered_map.
+struct FaceDAGHashHasher
+{
+  size_t operator()(const FaceDAGHash& h) const
+  {
+    return std::hash<uint64_t>()(h.hi ^ (h.lo * 0x9e3779b97f4a7c15ULL));
+  }
+};
+
+}  // end anonymous namespace
+
+OpSequence BestFirstOptimizer::rebuild(
+    const std::vector<Node>& nodes, size_t n, FaceDAG& h)
+{
+  std::vector<size_t> path;
+  while (nodes[n].parent != n)
+  {
+    path.push_back(n);
+    n = nodes[n].parent;
+  }
+  OpSequence res = OpSequence::make_empty();
+  for (auto it = path.rbegin(); it != path.rend(); ++it)
+  {
+    res += nodes[*it].ops;
+  }
+  res.apply(h);
+  return res;
+}
+
+OpSequence BestFirstOptimizer::solve(FaceDAG& g) const
+{
+  if (_lbound == nullptr)
+  {
+    throw std::runtime_error("Incomplete Solver");
+  }
+  this->_est.init(g);
+  _tt.clear();
+  reset_glob_opt();
+  _heuristics.reset();
+  _root = std::make_unique<const FaceDAG>(g);
+  _checkpoint.reset(0);
+  seed_glob_opt(g);
+  const count_t allocations = heap_allocations();
+
+  PeriodicThread writer, reporter;
+  start_glob_opt_writer(writer);
+  start_progress_reporter(reporter);
+
+  Trail trail;
+  std::vector<Node> nodes;
+  std::priority_queue<Open> open;
+  /* Cheapest cost so far of every face DAG that was reached. */
+  std::unordered_map<FaceDAGHash, flop_t, FaceDAGHashHasher> reached;
+
+  /* Memory of a node with its open list and hash map entries,
+   * without its operations. */
+  const size_t node_bytes = sizeof(Node) + sizeof(Open) +
+                            sizeof(FaceDAGHash) + sizeof(flop_t) +
+                            4 * sizeof(void*);
+  const size_t op_bytes = sizeof(OpCont) + 2 * sizeof(void*);
+  size_t bytes = node_bytes;
+
+  nodes.push_back(Node{0, OpSequence::make_empty(), 0, 0});
+  open.push(Open{(*(this->_lbound))(g), 0, 0});
+  reached.emplace(face_dag_hash(g), 0);
+
+  /* Expand nodes until the cheapest open node cannot
+   * improve the global optimum or the budget is exceeded. */
+  while (!open.empty() && open.top().f < glob_opt_cost() &&
+         bytes <= _memory_budget)
+  {
+    const Open o = open.top();
+    open.pop();
+    FaceDAG h = [&]()
+    {
+      StatTimer t(this->_stats, CopyTime);
+      return FaceDAG(g);
+    }();
+    const OpSequence prefix = [&]()
+    {
+      StatTimer t(this->_stats, ApplyTime);
+      return rebuild(nodes, o.n, h);
+    }();
+    const flop_t depth = nodes[o.n].depth;
+    this->_stats.add(Branch);
+
+    if (check_if_solved(h) == true)
+    {
+      this->_stats.add(Leaf);
+      update_global_opt(prefix);
+      continue;
+    }
+    if (_heuristics.run(depth, this->_est))
+    {
+      _heuristics.record(update_global_opt(prefix + heuristic_solve(h, trail)));
+      this->_stats.add(HeurRun);
+    }
+    else
+    {
+      this->_stats.add(HeurSkip);
+    }
+
+    /* The containers of the expansion are released at its end. */
+    ArenaScope scope;
+    ArenaVector<OpSequence> children = branches(h);
+    this->_est.add_sample(depth, children.size());
+    /* Derive the bounds of the children from the bound on h. */
+    std::unique_ptr<LowerBound::State> bound;
+    {
+      StatTimer t(this->_stats, BoundTime);
+      bound = this->_lbound->make_state(h);
+    }
+    TouchedVertices touched;
+    auto rollback = [&](const Trail::Mark mark)
+    {
+      {
+        StatTimer t(this->_stats, ApplyTime);
+        trail.rollback(h, mark);
+      }
+      if (bound)
+      {
+        StatTimer t(this->_stats, BoundTime);
+        this->_lbound->update(*bound, h, touched, 0);
+      }
+    };
+    for (auto& ops : children)
+    {
+      const Trail::Mark mark = trail.mark();
+      {
+        StatTimer t(this->_stats, ApplyTime);
+        ops.apply(h, &trail);
+      }
+      this->_stats.add(Perf);
+
+      const flop_t cost = o.cost + ops.cost();
+      const flop_t cutoff = glob_opt_cost() - cost;
+      flop_t lb;
+      if (bound)
+      {
+        StatTimer t(this->_stats, BoundTime);
+        touched.clear();
+        trail.touched(mark, [&](const VertexDesc v) { touched.push_back(v); });
+        lb = this->_lbound->update(*bound, h, touched, cutoff);
+      }
+      else
+      {
+        StatTimer t(this->_stats, BoundTime);
+        lb = this->_lbound->evaluate(h, cutoff);
+      }
+      const flop_t f = cost + lb;
+      if (f >= glob_opt_cost())
+      {
+        this->_est.add_cut(depth);
+        this->_stats.add(Bound);
+        rollback(mark);
+        continue;
+      }
+
+      /* Keep a face DAG only for the cheapest path to it. */
+      auto [it, inserted] = reached.emplace(face_dag_hash(h), cost);
+      if (!inserted && it->second <= cost)
+      {
+        this->_stats.add(TTHit);
+        rollback(mark);
+        continue;
+      }
+      it->second = cost;
+
+      bytes += node_bytes + ops.size() * op_bytes;
+      open.push(Open{f, cost, nodes.size()});
+      nodes.push_back(Node{o.n, std::move(ops), cost, depth + 1});
+      rollback(mark);
+    }
+  }
+
+  /* Out of memory: search the open nodes depth-first,
+   * most promising first. */
+  if (bytes > _memory_budget)
+  {
+    std::vector<Open> frontier;
+    frontier.reserve(open.size());
+    while (!open.empty())
+    {
+      frontier.push_back(open.top());
+      open.pop();
+    }
+    std::unordered_map<FaceDAGHash, flop_t, FaceDAGHashHasher>().swap(
+        reached);
+    const VertexDesc root = add_vertex(_meta_dag);
+
+    #pragma omp parallel default(shared)
+    {
+      #pragma omp single
+      {
+        for (const auto& o : frontier)
+        {
+          if (o.f >= glob_opt_cost())
+          {
+            break;
+          }
+          #pragma omp task default(shared) firstprivate(o)
+          {
+            if (o.f < glob_opt_cost())
+            {
+              FaceDAG h(g);
+              const OpSequence prefix = rebuild(nodes, o.n, h);
+              BranchAndBound::solve(
+                  h, OpPath(prefix), nodes[o.n].depth, root);
+            }
+          }  // end omp task
+        }
+      }
+    }
+  }
+
+  reporter.stop(false);
+  writer.stop();
+  this->_stats.add(HeapAlloc, heap_allocations() - allocations);
+  return *glob_opt();
+}
+
+}  // end namespace admission
@@ -3,26 +3,85 @@
 #include "optimizers/branch_and_bound.hpp"
 
 #include "graph/DAG.hpp"
+#include "graph/hash.hpp"
+#include "graph/solved_state.hpp"
 #include "graph/tikz.hpp"
+#include "graph/trail.hpp"
 #include "lower_bounds/lower_bound.hpp"
+#include "misc/arena.hpp"
+#include "misc/heap_counter.hpp"
+#include "misc/periodic_thread.hpp"
+#include "misc/thread_slot.hpp"
 #include "operations/find_eliminations.hpp"
+#include "operations/footprint.hpp"
 #include "optimizers/optimizer_stats.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <omp.h>
+#include <random>
 #include <stddef.h>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // **************************** Source contents ***************************** //
 
 namespace admission
 {
 
+namespace
+{
+
+/// Undo log of the face DAG a thread searches in place.
+thread_local Trail trail;
+
+/// A node on the search path of a thread searching in place.
+struct Frame
+{
+  /// State of the face DAG at the node.
+  Trail::Mark mark;
+  /// The operations leading from the root to the node.
+  const OpPath* until_now;
+  /// Depth of the node in the search tree.
+  flop_t depth;
+  /// Checkpoint::Path of the node if its depth is tracked.
+  const Checkpoint::Path* path;
+  /// The branches of the node.
+  const ArenaVector<OpSequence>* children;
+  /// The branches [next, end) are not tried yet.
+  size_t next, end;
+  /// A branch of the node or of one of its descendants was handed to
+  /// another thread, so the result of the node is incomplete.
+  bool donated;
+};
+
+/// Search path of the current thread in BnBMode::WorkStealing.
+thread_local std::vector<Frame> frames;
+
+}  // end anonymous namespace
+
+BnBMode to_bnb_mode(const std::string& s)
+{
+  if (s == "tasks")
+  {
+    return BnBMode::Tasks;
+  }
+  if (s == "work_stealing")
+  {
+    return BnBMode::WorkStealing;
+  }
+  throw std::runtime_error(
+      "Unknown branch and bound execution mode \"" + s +
+      "\"! Known modes are: tasks, work_stealing.");
+}
+
 OpSequence BranchAndBound::solve(FaceDAG& g) const
 {
   if (_lbound == nullptr)
@@ -30,8 +89,79 @@ OpSequence BranchAndBound::solve(FaceDAG& g) const
     throw std::runtime_error("Incomplete Solver");
   }
   this->_est.init(g);
+  _tt.clear();
+  reset_glob_opt();
+  _heuristics.reset();
+  _root = std::make_unique<const FaceDAG>(g);
+  const FaceDAGHash root_hash = Checkpoint::fingerprint(g);
+  const bool resumed = init_checkpoint(root_hash);
+  const bool seeded = seed_glob_opt(g);
+  const count_t allocations = heap_allocations();
   OpSequence res = OpSequence::make_max();
 
+  PeriodicThread writer, reporter, checkpointer;
+  start_glob_opt_writer(writer);
+  start_progress_reporter(reporter);
+  start_checkpoint_writer(checkpointer, root_hash);
+
+  if (_mode == BnBMode::WorkStealing)
+  {
+    if (_diagnostics)
+    {
+      std::ofstream writer("0.tex");
+      admission::write_tikz(writer, g);
+      writer.close();
+    }
+    const VertexDesc root = add_vertex(_meta_dag);
+
+    /* Open nodes are searched in place. Their results are merged
+     * through the global optimum only. */
+    auto process = [&](OpenNode& n)
+    {
+      if (n.depth > 0)
+      {
+        if (_checkpoint.resumed() && _checkpoint.tracks(n.depth) &&
+            _checkpoint.completed(n.path))
+        {
+          this->_stats.add(Resumed);
+          return;
+        }
+        const flop_t cutoff = glob_opt_cost() - n.prefix.cost();
+        flop_t lb;
+        {
+          StatTimer t(this->_stats, BoundTime);
+          lb = this->_lbound->evaluate(*n.g, cutoff);
+        }
+        if (lb >= cutoff)
+        {
+          this->_est.add_cut(n.depth - 1);
+          this->_stats.add(Bound);
+          return;
+        }
+        this->_stats.add(Branch);
+      }
+      solve(
+          *n.g, n.prefix, n.depth, root, SleepSet(), nullptr, nullptr,
+          nullptr, n.path);
+    };
+
+    _ws.init(omp_get_max_threads());
+    OpenNode n;
+    n.g.reset(new FaceDAG(g));
+    _ws.push(0, std::move(n));
+
+    #pragma omp parallel default(shared) num_threads(_ws.size())
+    {
+      _ws.run(omp_get_thread_num(), process);
+    }
+
+    reporter.stop(false);
+    checkpointer.stop();
+    writer.stop();
+    this->_stats.add(HeapAlloc, heap_allocations() - allocations);
+    return *glob_opt();
+  }
+
   #pragma omp parallel default(shared)
   {
     #pragma omp single
@@ -42,96 +172,255 @@ OpSequence BranchAndBound::solve(FaceDAG& g) const
         admission::write_tikz(writer, g);
         writer.close();
       }
-      res = solve(g, OpSequence::make_empty(), 0, add_vertex(_meta_dag));
+      res = solve(g, OpPath(), 0, add_vertex(_meta_dag));
     }
   }
 
-  return res;
+  reporter.stop(false);
+  checkpointer.stop();
+  writer.stop();
+  this->_stats.add(HeapAlloc, heap_allocations() - allocations);
+  /* Skipped subtrees and branches cut by the initial solution do not
+   * contribute to res, but to the global optimum read from the
+   * checkpoint or the file. */
+  return (resumed || seeded) ? *glob_opt() : res;
 }
 
 OpSequence BranchAndBound::solve(
-    FaceDAG& g, const OpSequence solution_until_now,
-    const flop_t parallel_depth, const VertexDesc source) const
+    FaceDAG& g, const OpPath& solution_until_now,
+    const flop_t parallel_depth, const VertexDesc source,
+    const SleepSet& sleep, SolvedState* solved,
+    LowerBound::State* bound, const OpSequence* hint,
+    const Checkpoint::Path& path) const
 {
-  /* After _interval write a single-line output
-   * providing information about solution progress. */
-  static double time = omp_get_wtime();
-  if (omp_get_wtime() - time > _interval)
+  /* Subtrees close to the root are recorded once they are completed,
+   * to resume the search from a checkpoint. */
+  auto record = [&]()
   {
-    #pragma omp critical
+    if (_checkpoint.tracks(parallel_depth))
     {
-      std::cout << (_output_mode ? "Est. Search Space: " : " ");
-      double est = this->_est.calc_est(0);
-      std::cout << est;
-      std::cout << (_output_mode ? " Search Space frac: " : " ");
-      std::cout << static_cast<double>(_stats.data[Branch]) / est;
-      std::cout << (_output_mode ? " Curr. Opt.: " : " ") << _glob_opt_s.cost()
-                << " ";
-      if (_output_mode == true)
-      {
-        this->_stats.write_human_readable(std::cout);
-      }
-      else
-      {
-        this->_stats.write_log(std::cout);
-      }
-      std::cout << std::endl;
-      time = omp_get_wtime();
+      _checkpoint.complete(path);
     }
-  }
+  };
 
   /* If this DAG is already solved i.e.
    * no eliminations and accumulations can
-   * be applied: return. */
-  if (check_if_solved(g) == true)
+   * be applied: return. While g is searched in place, the counters
+   * are updated by the caller, otherwise they are counted here. */
+  SolvedState own_solved;
+  if (solved == nullptr)
+  {
+    own_solved = SolvedState(g);
+    solved = &own_solved;
+  }
+  if (solved->solved() == true)
   {
     this->_stats.add(Leaf);
+    /* The parent updates the global optimum with the leaf only after it
+     * returned, too late for a checkpoint written in between. */
+    if (_checkpoint.tracks(parallel_depth))
+    {
+      update_global_opt(solution_until_now, OpSequence::make_empty());
+    }
+    record();
     return OpSequence::make_empty();
   }
 
+  /* Containers of the node are taken from the arena of the thread and
+   * released at once when its subtree is complete. */
+  ArenaScope scope;
+
+  /* If this face DAG was already searched on a different path,
+   * the stored lower bound of its cost-to-go may suffice to cut it. */
+  FaceDAGHash key;
+  if (_tt.enabled())
+  {
+    key = face_dag_hash(g);
+    TranspositionTable::Entry e;
+    if (_tt.probe(key, e))
+    {
+      this->_stats.add(TTHit);
+      if (e.lower + solution_until_now.cost() >= glob_opt_cost())
+      {
+        this->_stats.add(Bound);
+        record();
+        return OpSequence::make_max();
+      }
+    }
+    else
+    {
+      this->_stats.add(TTMiss);
+    }
+  }
+
+  /* Below the task-spawning depth, the whole subtree is searched by this
+   * thread on g itself. Operations are applied in place and rolled back
+   * with the trail afterwards. Above it, every branch is searched on a
+   * copy of g by a new task. Work stealing always searches in place. */
+  const bool stealing = (_mode == BnBMode::WorkStealing);
+  const Trail::Mark mark = trail.mark();
+  const bool in_place = stealing || (parallel_depth >= _parallel_depth);
+
+  /* The bound of a branch searched in place is derived from the bound
+   * on g, if the lower bound supports it. */
+  std::unique_ptr<LowerBound::State> own_bound;
+  if (in_place && bound == nullptr)
+  {
+    StatTimer t(this->_stats, BoundTime);
+    own_bound = this->_lbound->make_state(g);
+    bound = own_bound.get();
+  }
+
+  /* Split off work for idle threads before it is searched here. */
+  if (stealing && _ws.has_idle() && _ws.empty(omp_get_thread_num()))
+  {
+    donate(g);
+  }
+
   /* Use two different greedy heuristics to produce
    * a preliminary result on this DAG. If it results
    * in a new global optimum, update it. This ensures "decent"
    * global solutions early in the solution process, even
-   * if only few leaves were reached by the branch and bound. */
-  FaceDAG* hp = new FaceDAG(g);
-  auto branch_elims = _greedy_optimizer.greedy_solve(*hp, false);
-  *hp = g;
-  auto min_fill_in_elims = _min_fill_in_optimizer.min_fill_in_solve(*hp, false);
-  branch_elims = (min_fill_in_elims.cost() < branch_elims.cost()) ?
-                     min_fill_in_elims :
-                     branch_elims;
-  delete hp;
-  #pragma omp critical
-  {
-    update_global_opt(branch_elims + solution_until_now);
+   * if only few leaves were reached by the branch and bound.
+   * The policy skips them where they do not pay off, and a hint
+   * from the parent was already counted for the global optimum. */
+  OpSequence branch_elims = OpSequence::make_max();
+  if (hint != nullptr)
+  {
+    branch_elims = *hint;
+    this->_stats.add(HeurReuse);
   }
-
-  /* Struct for counting the number of elims we will
-   * execute. Passed as a callable object to traverse_elims.
-   * To get an estimate of the search space. */
-  struct count_elim
+  else if (_heuristics.run(parallel_depth, this->_est))
+  {
+    branch_elims = heuristic_solve(g, trail);
+    _heuristics.record(update_global_opt(solution_until_now, branch_elims));
+    this->_stats.add(HeurRun);
+  }
+  else
   {
-    size_t _c = 0;
+    this->_stats.add(HeurSkip);
+  }
+
+  /* Collect all operations we will branch on. Their number
+   * gives a sample for the estimate of the search space. */
+  ArenaVector<OpSequence> children = branches(g);
+  this->_est.add_sample(parallel_depth, children.size());
 
-    void operator()(const FaceDAG&, const OpSequence&)
+  /* With partial order reduction, a branch sleeps in the subtrees of its
+   * younger siblings it is independent of. Sequences starting with it were
+   * already searched in its own subtree, in a different order. The
+   * transposition table already finds these orders, and nodes with
+   * sleeping branches cannot be stored in it, so it takes precedence. */
+  const bool por = _por && !_tt.enabled();
+  ArenaVector<Footprint> footprints;
+  ArenaVector<bool> asleep;
+  if (por)
+  {
+    footprints.reserve(children.size());
+    for (const auto& c : children)
     {
-      ++_c;
+      footprints.push_back(footprint(c, g, trail));
     }
-  } ctr;
+    asleep.resize(children.size(), false);
+  }
 
-  traverse_elims(g, ctr, ctr);
-  this->_est.add_sample(parallel_depth, ctr._c);
+  /* Lambda searching the subtree on h, which already has
+   * subbranch_elims applied, and updating the optima. */
+  auto search = [&](FaceDAG& h, OpSequence subbranch_elims, VertexDesc mv,
+                    meta_dag_info_t* info, const SleepSet& child_sleep,
+                    SolvedState* h_solved, LowerBound::State* h_bound,
+                    const OpSequence* h_hint, const Checkpoint::Path& h_path)
+  {
+    this->_stats.add(Branch);
+    subbranch_elims += solve(
+        h, solution_until_now + subbranch_elims, parallel_depth + 1, mv,
+        child_sleep, h_solved, h_bound, h_hint, h_path);
+
+    /* Check if the optimal solution on h is better than the current optimum. */
+    #pragma omp critical
+    {
+      if (subbranch_elims.cost() < branch_elims.cost())
+      {
+        branch_elims = subbranch_elims;
+        /* Check if this solution is better than the global optimum. */
+        bool updated = update_global_opt(solution_until_now, branch_elims);
+        if (updated && _diagnostics)
+        {
+          info->was_opt = true;
+          boost::set_property(_meta_dag, boost::graph_opt, mv);
+        }
+      }
+    }  // end omp critical
+  };
+
+  /* Vertices touched by a branch, to recount them in place. */
+  TouchedVertices touched;
 
   /* Lambda for simplifying the branching, performing an operation
    * checking the bound and, in case, starting the subtree search.
    */
-  auto branch_if = [&](const FaceDAG& g, OpSequence subbranch_elims)
+  auto branch_if = [&](const size_t c)
   {
+    const OpSequence& subbranch_elims = children[c];
+    SleepSet child_sleep;
+    if (por)
+    {
+      for (const auto& z : sleep)
+      {
+        if (same_operations(z.ops, subbranch_elims))
+        {
+          asleep[c] = true;
+          this->_est.add_cut(parallel_depth);
+          this->_stats.add(PORSkip);
+          return;
+        }
+      }
+      for (const auto& z : sleep)
+      {
+        if (independent(z.fp, footprints[c]))
+        {
+          child_sleep.push_back(z);
+        }
+      }
+      for (size_t y = 0; y < c; ++y)
+      {
+        if (!asleep[y] && independent(footprints[y], footprints[c]))
+        {
+          child_sleep.push_back(SleepingBranch{children[y], footprints[y]});
+        }
+      }
+    }
+
+    /* Subtrees completed before the checkpoint are not searched again. */
+    Checkpoint::Path child_path;
+    if (_checkpoint.tracks(parallel_depth + 1))
+    {
+      child_path = Checkpoint::child(path, c);
+      if (_checkpoint.resumed() && _checkpoint.completed(child_path))
+      {
+        this->_stats.add(Resumed);
+        return;
+      }
+    }
+
     this->_stats.add(Perf);
 
-    FaceDAG* hp = new FaceDAG(g);
-    subbranch_elims.apply(*hp);
+    FaceDAG* hp = &g;
+    if (!in_place)
+    {
+      StatTimer t(this->_stats, CopyTime);
+      hp = new FaceDAG(g);
+    }
+    {
+      StatTimer t(this->_stats, ApplyTime);
+      subbranch_elims.apply(*hp, in_place ? &trail : nullptr);
+      if (in_place)
+      {
+        touched.clear();
+        trail.touched(mark, [&](const VertexDesc v) { touched.push_back(v); });
+        solved->update(g, touched);
+      }
+    }
 
     /* If _diagnostics are activated add a vertex to the meta DAG. */
     VertexDesc mv = 0;
@@ -148,37 +437,47 @@ OpSequence BranchAndBound::solve(
     }
 
     /* Check, whether the result should be searched recursively. */
-    flop_t lb = (*(this->_lbound))(*hp);
-    if ((lb + subbranch_elims.cost() + solution_until_now.cost() <
-         _glob_opt_s.cost()) &&
-        (lb + subbranch_elims.cost() < branch_elims.cost()))
-    {
-      #pragma omp task default(shared) \
-                       firstprivate(subbranch_elims, parallel_depth) \
-                       firstprivate(solution_until_now, hp, source, mv, info) \
-                       final(parallel_depth >= _parallel_depth)
+    const flop_t cutoff =
+        std::min(
+            glob_opt_cost() - solution_until_now.cost(), branch_elims.cost()) -
+        subbranch_elims.cost();
+    flop_t lb;
+    {
+      StatTimer t(this->_stats, BoundTime);
+      lb = bound ? this->_lbound->update(*bound, g, touched, cutoff) :
+                   this->_lbound->evaluate(*hp, cutoff);
+    }
+    if (lb < cutoff)
+    {
+      if (in_place)
       {
-        this->_stats.add(Branch);
-        subbranch_elims += solve(
-            *hp, solution_until_now + subbranch_elims, parallel_depth + 1, mv);
-
-        /* Check if the optimal solution on h is better than the current optimum. */
-        #pragma omp critical
+        /* The rest of the best sequence on g solves the child
+         * if it starts with the branch. */
+        OpSequence hint = OpSequence::make_max();
+        const bool reuse =
+            _heuristics.reuse() && branch_elims.starts_with(subbranch_elims);
+        if (reuse)
         {
-          if (subbranch_elims.cost() < branch_elims.cost())
-          {
-            branch_elims = subbranch_elims;
-            /* Check if this solution is better than the global optimum. */
-            bool updated = update_global_opt(branch_elims + solution_until_now);
-            if (updated && _diagnostics)
-            {
-              info->was_opt = true;
-              boost::set_property(_meta_dag, boost::graph_opt, mv);
-            }
-          }
-        }  // end omp critical
-        delete hp;
-      }  // end omp task
+          hint = branch_elims;
+          hint.remove_prefix(subbranch_elims);
+        }
+        search(
+            g, subbranch_elims, mv, info, child_sleep, solved, bound,
+            reuse ? &hint : nullptr, child_path);
+      }
+      else
+      {
+        #pragma omp task default(shared) \
+                         firstprivate(subbranch_elims, hp, mv, info) \
+                         firstprivate(child_sleep, child_path)
+        {
+          search(
+              *hp, subbranch_elims, mv, info, child_sleep, nullptr, nullptr,
+              nullptr, child_path);
+          delete hp;
+        }  // end omp task
+        hp = nullptr;
+      }
     }
     else
     {
@@ -188,16 +487,383 @@ OpSequence BranchAndBound::solve(
       {
         info->cut = true;
       }
+    }
+
+    if (in_place)
+    {
+      {
+        StatTimer t(this->_stats, ApplyTime);
+        trail.rollback(g, mark);
+        solved->update(g, touched);
+      }
+      if (bound)
+      {
+        StatTimer t(this->_stats, BoundTime);
+        this->_lbound->update(*bound, g, touched, 0);
+      }
+    }
+    else
+    {
       delete hp;
     }
   };
 
-  traverse_elims(g, branch_if, branch_if);
-  #pragma omp taskwait
+  bool complete = true;
+  if (stealing)
+  {
+    /* Branches are taken from the front of the frame, while donate(...)
+     * takes them from its end. */
+    const size_t fi = frames.size();
+    frames.push_back(
+        Frame{mark, &solution_until_now, parallel_depth, &path, &children,
+              0, children.size(), false});
+    while (frames[fi].next < frames[fi].end)
+    {
+      branch_if(frames[fi].next++);
+    }
+    complete = !frames[fi].donated;
+    frames.pop_back();
+  }
+  else
+  {
+    for (size_t c = 0; c < children.size(); ++c)
+    {
+      branch_if(c);
+    }
+  }
+  if (!in_place)
+  {
+    #pragma omp taskwait
+  }
+
+  /* All branches were either searched or cut by the bound, so no
+   * sequence cheaper than branch_elims or than the remainder of the
+   * global optimum can exist on g. Not so if sleeping branches
+   * were skipped. */
+  if (_tt.enabled() && complete && sleep.empty())
+  {
+    flop_t lower = std::min(
+        branch_elims.cost(), glob_opt_cost() - solution_until_now.cost());
+    _tt.store(
+        key, std::max<flop_t>(lower, 0), branch_elims.cost(), parallel_depth);
+  }
+  if (complete)
+  {
+    record();
+  }
 
   return branch_elims;
 }
 
+void BranchAndBound::donate(const FaceDAG& g) const
+{
+  for (size_t fi = 0; fi < frames.size(); ++fi)
+  {
+    Frame& f = frames[fi];
+    if (f.next == f.end)
+    {
+      continue;
+    }
+
+    /* Restore the face DAG of the node on a copy of g and
+     * apply the branch to it. */
+    const size_t c = --f.end;
+    const OpSequence& s = (*f.children)[c];
+    OpenNode n;
+    {
+      StatTimer t(this->_stats, CopyTime);
+      n.g.reset(new FaceDAG(g));
+      trail.restore(*n.g, f.mark);
+    }
+    {
+      StatTimer t(this->_stats, ApplyTime);
+      s.apply(*n.g);
+    }
+    this->_stats.add(Perf);
+    n.prefix = *f.until_now + s;
+    n.depth = f.depth + 1;
+    if (_checkpoint.tracks(n.depth))
+    {
+      n.path = Checkpoint::child(*f.path, c);
+    }
+    _ws.donate(omp_get_thread_num(), std::move(n));
+
+    /* The node and its ancestors miss the result of the branch. */
+    for (size_t a = 0; a <= fi; ++a)
+    {
+      frames[a].donated = true;
+    }
+    return;
+  }
+}
+
+double BranchAndBound::probe_search_space(
+    const FaceDAG& root, const size_t probes,
+    const std::function<bool()>& cancelled) const
+{
+  thread_local std::mt19937_64 rng(0x9e3779b97f4a7c15ULL + thread_slot());
+  FaceDAG g(root);
+  Trail t;
+  double sum = 0;
+  for (size_t p = 0; p < probes; ++p)
+  {
+    /* Descend along random branches that the bound does not cut.
+     * The product of the numbers of such branches along the path
+     * estimates the number of nodes at every depth. A probe out of
+     * budget stops before the depth it could not evaluate completely. */
+    const Trail::Mark start = t.mark();
+    flop_t cost = 0;
+    double width = 1;
+    double size = 1;
+    size_t evals = 0;
+    bool exhausted = false;
+    while (!exhausted && !check_if_solved(g))
+    {
+      ArenaScope scope;
+      ArenaVector<OpSequence> children = branches(g);
+      ArenaVector<size_t> open;
+      for (size_t c = 0; c < children.size(); ++c)
+      {
+        if ((_probe_budget > 0 && evals++ == _probe_budget) || cancelled())
+        {
+          exhausted = true;
+          break;
+        }
+        const Trail::Mark m = t.mark();
+        children[c].apply(g, &t);
+        const flop_t cutoff = glob_opt_cost() - cost - children[c].cost();
+        if (this->_lbound->evaluate(g, cutoff) < cutoff)
+        {
+          open.push_back(c);
+        }
+        t.rollback(g, m);
+      }
+      if (exhausted || open.empty())
+      {
+        break;
+      }
+      width *= open.size();
+      size += width;
+      const OpSequence& s = children[open[rng() % open.size()]];
+      s.apply(g, &t);
+      cost += s.cost();
+    }
+    t.rollback(g, start);
+    if (cancelled())
+    {
+      return 0;
+    }
+    sum += size;
+  }
+  return sum / probes;
+}
+
+void BranchAndBound::start_glob_opt_writer(PeriodicThread& writer) const
+{
+  auto written = glob_opt();
+  writer.start(
+      _interval,
+      [this, written]() mutable
+      {
+        auto s = glob_opt();
+        if (s != written)
+        {
+          std::ofstream o("adm_glob_opt_s");
+          s->write(o);
+          written = s;
+        }
+      });
+}
+
+void BranchAndBound::start_progress_reporter(PeriodicThread& reporter) const
+{
+  const PeriodicThread* thread = &reporter;
+  auto json = std::make_shared<std::ofstream>();
+  if (!_progress_path.empty())
+  {
+    json->open(_progress_path);
+  }
+  const double start = omp_get_wtime();
+  reporter.start(
+      _interval,
+      [this, json, start, thread]()
+      {
+        this->_est.merge();
+        if (_root && _probes > 0)
+        {
+          /* The probes give up once the search completed. */
+          const double probed = probe_search_space(
+              *_root, _probes, [thread]() { return thread->stopping(); });
+          if (thread->stopping())
+          {
+            return;
+          }
+          this->_est.set_probe_estimate(probed);
+        }
+        double est = this->_est.probe_estimate();
+        if (est == 0)
+        {
+          est = this->_est.calc_est(0);
+        }
+        const double frac = static_cast<double>(_stats.get(Branch)) / est;
+        const flop_t opt = glob_opt_cost();
+
+        std::cout << (_output_mode ? "Est. Search Space: " : " ") << est;
+        std::cout << (_output_mode ? " Search Space frac: " : " ") << frac;
+        std::cout << (_output_mode ? " Curr. Opt.: " : " ") << opt << " ";
+        if (_output_mode == true)
+        {
+          this->_stats.write_human_readable(std::cout);
+        }
+        else
+        {
+          this->_stats.write_log(std::cout);
+        }
+        std::cout << std::endl;
+
+        if (json->is_open())
+        {
+          /* JSON has no literals for infinite and undefined numbers. */
+          auto number = [](std::ostream& os, const double x)
+          {
+            if (std::isfinite(x))
+            {
+              os << x;
+            }
+            else
+            {
+              os << "null";
+            }
+          };
+          *json << "{\"time\":" << omp_get_wtime() - start
+                << ",\"est_search_space\":";
+          number(*json, est);
+          *json << ",\"search_space_frac\":";
+          number(*json, frac);
+          *json << ",\"glob_opt\":" << opt << ",";
+          this->_stats.write_json(*json);
+          *json << "}" << std::endl;
+        }
+      });
+}
+
+bool BranchAndBound::seed_glob_opt(const FaceDAG& g) const
+{
+  if (_initial_solution.empty())
+  {
+    return false;
+  }
+  OpSequence s = OpSequence::make_empty();
+  try
+  {
+    std::ifstream in(_initial_solution);
+    if (!in)
+    {
+      throw std::runtime_error("cannot read the file.");
+    }
+    read_sequence(std::move(in), s);
+    /* Replaying validates the operations on g and their costs
+     * may differ from the DAG the solution was written for. */
+    FaceDAG h(g);
+    s = s.replay(h);
+    if (!check_if_solved(h))
+    {
+      throw std::runtime_error("it does not solve the face DAG.");
+    }
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cout << "Initial solution " << _initial_solution.string()
+              << " is ignored, " << e.what() << std::endl;
+    return false;
+  }
+  update_global_opt(s);
+  std::cout << "Starting with initial solution " << _initial_solution.string()
+            << " of cost " << s.cost() << "fma." << std::endl;
+  return true;
+}
+
+bool BranchAndBound::init_checkpoint(const FaceDAGHash& root) const
+{
+  const bool track = !_checkpoint_path.empty() || !_resume_path.empty();
+  _checkpoint.reset(track ? _checkpoint_depth : 0);
+  if (_resume_path.empty())
+  {
+    return false;
+  }
+  std::ifstream in(_resume_path);
+  if (!in)
+  {
+    std::cout << "No checkpoint " << _resume_path.string() << ", starting anew."
+              << std::endl;
+    return false;
+  }
+  OpSequence incumbent = OpSequence::make_empty();
+  if (!_checkpoint.read(in, root, incumbent, this->_stats, this->_est))
+  {
+    std::cout << "Checkpoint " << _resume_path.string()
+              << " belongs to a different face DAG, starting anew."
+              << std::endl;
+    return false;
+  }
+  /* The checkpoint may be written before the first solution. */
+  if (!incumbent.empty())
+  {
+    update_global_opt(incumbent);
+  }
+  std::cout << "Resuming from " << _resume_path.string() << " with "
+            << _checkpoint.size() << " completed subtrees." << std::endl;
+  return true;
+}
+
+void BranchAndBound::start_checkpoint_writer(
+    PeriodicThread& writer, const FaceDAGHash& root) const
+{
+  if (_checkpoint_path.empty())
+  {
+    return;
+  }
+  writer.start(
+      _checkpoint_interval,
+      [this, root]()
+      {
+        fs::path tmp = _checkpoint_path;
+        tmp += ".tmp";
+        {
+          std::ofstream o(tmp);
+          _checkpoint.write(
+              o, root, [this]() { return *glob_opt(); }, this->_stats,
+              this->_est);
+        }
+        fs::rename(tmp, _checkpoint_path);
+      });
+}
+
+OpSequence BranchAndBound::heuristic_solve(FaceDAG& g, Trail& trail) const
+{
+  StatTimer t(this->_stats, HeuristicTime);
+  const Trail::Mark mark = trail.mark();
+  auto greedy_elims = _greedy_optimizer.greedy_solve(g, false, &trail);
+  trail.rollback(g, mark);
+  auto min_fill_in_elims =
+      _min_fill_in_optimizer.min_fill_in_solve(g, false, &trail);
+  trail.rollback(g, mark);
+  return (min_fill_in_elims.cost() < greedy_elims.cost()) ? min_fill_in_elims :
+                                                            greedy_elims;
+}
+
+ArenaVector<OpSequence> BranchAndBound::branches(const FaceDAG& g) const
+{
+  StatTimer t(this->_stats, TraversalTime);
+  ArenaVector<OpSequence> res;
+  auto collect = [&res](const FaceDAG&, const OpSequence& s)
+  {
+    res.push_back(s);
+  };
+  traverse_elims(g, collect, collect);
+  return res;
+}
+
 /**\brief Traverses all possible preaccumulations and eliminations (operations)
  *        on a face DAG. For each operation, it performs some task specified
  *        by the callables passed to it.
@@ -223,192 +889,197 @@ void BranchAndBound::traverse_elims(
     }
   }
 
-  BOOST_FOREACH(auto ijk, edges(g))
+  /* Iterate over the out-edges of all vertices rather than edges(g),
+   * whose order changes when edges are restored from a Trail. */
+  BOOST_FOREACH(auto v, vertices(g))
   {
-    VertexDesc ij = boost::source(ijk, g);
-    VertexDesc jk = boost::target(ijk, g);
-
-    if (!in_degree(ij, g) || !out_degree(jk, g))
+    BOOST_FOREACH(auto ijk, out_edges(v, g))
     {
-      continue;
-    }
+      VertexDesc ij = boost::source(ijk, g);
+      VertexDesc jk = boost::target(ijk, g);
 
-    // auto i = *(in_edges(ij,g).first);
-    // auto k = *(out_edges(jk,g).first);
+      if (!in_degree(ij, g) || !out_degree(jk, g))
+      {
+        continue;
+      }
 
-    OpSequence ij_acc_s = cheapest_preacc(ij, g);
-    OpSequence jk_acc_s = cheapest_preacc(jk, g);
+      // auto i = *(in_edges(ij,g).first);
+      // auto k = *(out_edges(jk,g).first);
 
-    OpSequence adj_s = adj_prop(ijk, g);
-    OpSequence tan_s = tan_prop(ijk, g);
-    OpSequence mul_s = mul(ijk, g);
+      OpSequence ij_acc_s = cheapest_preacc(ij, g);
+      OpSequence jk_acc_s = cheapest_preacc(jk, g);
 
-    flop_t ppm_c = ij_acc_s.cost() + jk_acc_s.cost() + mul_s.cost();
-    flop_t pt_c = ij_acc_s.cost() + tan_s.cost();
-    flop_t pa_c = jk_acc_s.cost() + adj_s.cost();
+      OpSequence adj_s = adj_prop(ijk, g);
+      OpSequence tan_s = tan_prop(ijk, g);
+      OpSequence mul_s = mul(ijk, g);
 
-    // Case where both jacobians are accumulated.
-    // We can
-    //  - multiply
-    //  - propagate v through w if w has a tangent model
-    //  - propagate w through v if v has an adjoint model
-    if (Fprime_exists[ij] == true && Fprime_exists[jk] == true)
-    {
-      if (Fbardot_exists[ij] && Fbardot_exists[jk])
+      flop_t ppm_c = ij_acc_s.cost() + jk_acc_s.cost() + mul_s.cost();
+      flop_t pt_c = ij_acc_s.cost() + tan_s.cost();
+      flop_t pa_c = jk_acc_s.cost() + adj_s.cost();
+
+      // Case where both jacobians are accumulated.
+      // We can
+      //  - multiply
+      //  - propagate v through w if w has a tangent model
+      //  - propagate w through v if v has an adjoint model
+      if (Fprime_exists[ij] == true && Fprime_exists[jk] == true)
       {
-        if (adj_s.cost() <= tan_s.cost() && adj_s.cost() <= mul_s.cost())
+        if (Fbardot_exists[ij] && Fbardot_exists[jk])
         {
-          edge_action(g, adj_s);
-        }
-        else if (tan_s.cost() <= mul_s.cost())
-        {
-          edge_action(g, tan_s);
+          if (adj_s.cost() <= tan_s.cost() && adj_s.cost() <= mul_s.cost())
+          {
+            edge_action(g, adj_s);
+          }
+          else if (tan_s.cost() <= mul_s.cost())
+          {
+            edge_action(g, tan_s);
+          }
+          else
+          {
+            edge_action(g, mul_s);
+          }
         }
-        else
+        else if (Fbardot_exists[ij])
         {
-          edge_action(g, mul_s);
+          if (adj_s.cost() < mul_s.cost())
+          {
+            edge_action(g, adj_s);
+          }
+          else
+          {
+            edge_action(g, mul_s);
+          }
         }
-      }
-      else if (Fbardot_exists[ij])
-      {
-        if (adj_s.cost() < mul_s.cost())
+        else if (Fbardot_exists[jk])
         {
-          edge_action(g, adj_s);
+          if (tan_s.cost() < mul_s.cost())
+          {
+            edge_action(g, tan_s);
+          }
+          else
+          {
+            edge_action(g, mul_s);
+          }
         }
         else
         {
           edge_action(g, mul_s);
         }
       }
-      else if (Fbardot_exists[jk])
+      else if (Fprime_exists[ij] == true && Fprime_exists[jk] == false)
       {
-        if (tan_s.cost() < mul_s.cost())
+        if ((mul_s.cost() <= adj_s.cost() || !Fbardot_exists[ij]) &&
+            (in_degree(jk, g) > 1 ||
+             (jk_acc_s.cost() + mul_s.cost() < tan_s.cost())))
         {
-          edge_action(g, tan_s);
+          // Check the ACC and MUL case
+          edge_action(g, jk_acc_s + mul_s);
         }
-        else
+
+        if ((Fbardot_exists[ij] && adj_s.cost() < mul_s.cost()) &&
+            (in_degree(jk, g) > 1 ||
+             (jk_acc_s.cost() + adj_s.cost() < tan_s.cost())))
         {
-          edge_action(g, mul_s);
+          edge_action(g, jk_acc_s + adj_s);
         }
-      }
-      else
-      {
-        edge_action(g, mul_s);
-      }
-    }
-    else if (Fprime_exists[ij] == true && Fprime_exists[jk] == false)
-    {
-      if ((mul_s.cost() <= adj_s.cost() || !Fbardot_exists[ij]) &&
-          (in_degree(jk, g) > 1 ||
-           (jk_acc_s.cost() + mul_s.cost() < tan_s.cost())))
-      {
-        // Check the ACC and MUL case
-        edge_action(g, jk_acc_s + mul_s);
-      }
 
-      if ((Fbardot_exists[ij] && adj_s.cost() < mul_s.cost()) &&
-          (in_degree(jk, g) > 1 ||
-           (jk_acc_s.cost() + adj_s.cost() < tan_s.cost())))
-      {
-        edge_action(g, jk_acc_s + adj_s);
-      }
-
-      if (in_degree(jk, g) > 1 ||
-          ((jk_acc_s.cost() + adj_s.cost() >= tan_s.cost() ||
-            !Fbardot_exists[ij]) &&
-           jk_acc_s.cost() + mul_s.cost() >= tan_s.cost()))
-      {
-        // Check the TAN Propagation cost
-        edge_action(g, tan_s);
-      }
-    }
-    else if (Fprime_exists[ij] == false && Fprime_exists[jk] == true)
-    {
-      if ((mul_s.cost() < tan_s.cost() || !Fbardot_exists[jk]) &&
-          (out_degree(ij, g) > 1 ||
-           (ij_acc_s.cost() + mul_s.cost() < adj_s.cost())))
-      {
-        // Check the ACC and MUL case
-        edge_action(g, ij_acc_s + mul_s);
-      }
-      if ((mul_s.cost() >= tan_s.cost() && Fbardot_exists[jk]) &&
-          (out_degree(ij, g) > 1 ||
-           (ij_acc_s.cost() + tan_s.cost() < adj_s.cost())))
-      {
-        // Check the ACC and MUL case
-        edge_action(g, ij_acc_s + tan_s);
-      }
-
-      if (out_degree(ij, g) > 1 ||
-          ((ij_acc_s.cost() + tan_s.cost() >= adj_s.cost() ||
-            !Fbardot_exists[jk]) &&
-           ij_acc_s.cost() + mul_s.cost() >= adj_s.cost()))
-      {
-        // Check the ADJ Propagation cost
-        edge_action(g, adj_s);
-      }
-    }
-    else  // both are unaccumulated
-    {
-      if (!Fbardot_exists[ij])
-      {
-        throw std::runtime_error{"A vertex has no model and no jacobian!"};
-      }
-      if (!Fbardot_exists[jk])
-      {
-        throw std::runtime_error{"A vertex has no model and no jacobian!"};
+        if (in_degree(jk, g) > 1 ||
+            ((jk_acc_s.cost() + adj_s.cost() >= tan_s.cost() ||
+              !Fbardot_exists[ij]) &&
+             jk_acc_s.cost() + mul_s.cost() >= tan_s.cost()))
+        {
+          // Check the TAN Propagation cost
+          edge_action(g, tan_s);
+        }
       }
-
-      if (in_degree(jk, g) == 1 && out_degree(ij, g) == 1)
+      else if (Fprime_exists[ij] == false && Fprime_exists[jk] == true)
       {
-        if (ppm_c == std::min({ppm_c, pt_c, pa_c}))
+        if ((mul_s.cost() < tan_s.cost() || !Fbardot_exists[jk]) &&
+            (out_degree(ij, g) > 1 ||
+             (ij_acc_s.cost() + mul_s.cost() < adj_s.cost())))
         {
-          edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          // Check the ACC and MUL case
+          edge_action(g, ij_acc_s + mul_s);
         }
-        else if (pt_c <= pa_c)
+        if ((mul_s.cost() >= tan_s.cost() && Fbardot_exists[jk]) &&
+            (out_degree(ij, g) > 1 ||
+             (ij_acc_s.cost() + tan_s.cost() < adj_s.cost())))
         {
+          // Check the ACC and MUL case
           edge_action(g, ij_acc_s + tan_s);
         }
-        else
+
+        if (out_degree(ij, g) > 1 ||
+            ((ij_acc_s.cost() + tan_s.cost() >= adj_s.cost() ||
+              !Fbardot_exists[jk]) &&
+             ij_acc_s.cost() + mul_s.cost() >= adj_s.cost()))
         {
-          edge_action(g, jk_acc_s + adj_s);
+          // Check the ADJ Propagation cost
+          edge_action(g, adj_s);
         }
       }
-      else if (out_degree(ij, g) > 1 && in_degree(jk, g) == 1)
+      else  // both are unaccumulated
       {
-        edge_action(g, jk_acc_s + adj_s);
-
-        if (ppm_c <= pt_c)
+        if (!Fbardot_exists[ij])
         {
-          edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          throw std::runtime_error{"A vertex has no model and no jacobian!"};
         }
-        else
+        if (!Fbardot_exists[jk])
         {
-          edge_action(g, ij_acc_s + tan_s);
+          throw std::runtime_error{"A vertex has no model and no jacobian!"};
         }
-      }
-      else if (out_degree(ij, g) == 1 && in_degree(jk, g) > 1)
-      {
-        edge_action(g, ij_acc_s + tan_s);
 
-        if (ppm_c <= pa_c)
+        if (in_degree(jk, g) == 1 && out_degree(ij, g) == 1)
         {
-          edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          if (ppm_c == std::min({ppm_c, pt_c, pa_c}))
+          {
+            edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          }
+          else if (pt_c <= pa_c)
+          {
+            edge_action(g, ij_acc_s + tan_s);
+          }
+          else
+          {
+            edge_action(g, jk_acc_s + adj_s);
+          }
+        }
+        else if (out_degree(ij, g) > 1 && in_degree(jk, g) == 1)
+        {
+          edge_action(g, jk_acc_s + adj_s);
+
+          if (ppm_c <= pt_c)
+          {
+            edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          }
+          else
+          {
+            edge_action(g, ij_acc_s + tan_s);
+          }
+        }
+        else if (out_degree(ij, g) == 1 && in_degree(jk, g) > 1)
+        {
+          edge_action(g, ij_acc_s + tan_s);
+
+          if (ppm_c <= pa_c)
+          {
+            edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          }
+          else
+          {
+            edge_action(g, ij_acc_s + jk_acc_s + adj_s);
+          }
         }
         else
         {
-          edge_action(g, ij_acc_s + jk_acc_s + adj_s);
+          // Accmumulate both and matmul
+          edge_action(g, ij_acc_s + jk_acc_s + mul_s);
+          // Accumulate v and propagate tangent
+          edge_action(g, ij_acc_s + tan_s);
+          // Accumulate w and propagate adjoint
+          edge_action(g, jk_acc_s + adj_s);
         }
       }
-      else
-      {
-        // Accmumulate both and matmul
-        edge_action(g, ij_acc_s + jk_acc_s + mul_s);
-        // Accumulate v and propagate tangent
-        edge_action(g, ij_acc_s + tan_s);
-        // Accumulate w and propagate adjoint
-        edge_action(g, jk_acc_s + adj_s);
-      }
     }
   }  // end FOR_EACH over all edges
 }
@@ -0,0 +1,182 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/checkpoint.hpp"
+
+#include "misc/mix.hpp"
+
+#include <boost/foreach.hpp>
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stddef.h>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/// Reads the next n lines of is, with their line breaks.
+std::string read_lines(std::istream& is, const size_t n)
+{
+  std::string res, line;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (!std::getline(is, line))
+    {
+      throw std::runtime_error("Checkpoint ended unexpectedly!");
+    }
+    res += line + "\n";
+  }
+  return res;
+}
+
+/// Reads the word w from is.
+void expect(std::istream& is, const std::string& w)
+{
+  std::string s;
+  if (!(is >> s) || s != w)
+  {
+    throw std::runtime_error(
+        "Expected \"" + w + "\" in checkpoint, got \"" + s + "\"!");
+  }
+}
+
+/// Reads a value of type T from is.
+template<typename T>
+T read_value(std::istream& is)
+{
+  T n;
+  if (!(is >> n))
+  {
+    throw std::runtime_error("Checkpoint is corrupted!");
+  }
+  return n;
+}
+
+}  // end anonymous namespace
+
+FaceDAGHash Checkpoint::fingerprint(const FaceDAG& g)
+{
+  FaceDAGHash res = face_dag_hash(g);
+  BOOST_FOREACH(auto e, edges(g))
+  {
+    const uint64_t i = static_cast<uint64_t>(index(e, g));
+    const uint64_t s =
+        static_cast<uint64_t>(boost::get(boost::edge_size, g, e));
+    res.hi += mix(mix(i) ^ s);
+    res.lo += mix(mix(s) ^ i);
+  }
+  return res;
+}
+
+void Checkpoint::complete(const Path& path)
+{
+  const Path below = path + ".";
+  std::lock_guard<std::mutex> lock(_m);
+  /* Paths of subtrees below path start with path and a dot,
+   * and follow each other in the set. */
+  auto it = _completed.lower_bound(below);
+  while (it != _completed.end() && it->compare(0, below.size(), below) == 0)
+  {
+    it = _completed.erase(it);
+  }
+  _completed.insert(path);
+}
+
+bool Checkpoint::completed(const Path& path) const
+{
+  std::lock_guard<std::mutex> lock(_m);
+  return _completed.count(path) > 0;
+}
+
+void Checkpoint::write(
+    std::ostream& os, const FaceDAGHash& root,
+    const std::function<OpSequence()>& incumbent,
+    const OptimizerStats& stats, const Estimator& est) const
+{
+  /* A subtree updates the global optimum before it completes. Reading
+   * the optimum last ensures it is as good as every subtree written. */
+  std::set<Path> completed;
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    completed = _completed;
+  }
+  const OpSequence opt = incumbent();
+
+  os << "ADMission checkpoint\n";
+  os << "root " << root.hi << " " << root.lo << "\n";
+  os << "incumbent " << opt.size() << "\n";
+  opt.write(os);
+  os << "stats ";
+  stats.save(os);
+  os << "estimator ";
+  est.save(os);
+  os << "completed " << completed.size() << "\n";
+  for (const Path& p : completed)
+  {
+    os << "subtree " << p << "\n";
+  }
+  os << "end" << std::endl;
+}
+
+bool Checkpoint::read(
+    std::istream& is, const FaceDAGHash& root, OpSequence& incumbent,
+    OptimizerStats& stats, Estimator& est)
+{
+  expect(is, "ADMission");
+  expect(is, "checkpoint");
+  expect(is, "root");
+  FaceDAGHash h;
+  h.hi = read_value<uint64_t>(is);
+  h.lo = read_value<uint64_t>(is);
+  if (h != root)
+  {
+    return false;
+  }
+
+  expect(is, "incumbent");
+  size_t n = read_value<size_t>(is);
+  is >> std::ws;
+  OpSequence opt = OpSequence::make_empty();
+  read_sequence(std::istringstream(read_lines(is, n)), opt);
+
+  /* The counters are read into scratch objects first, so a broken
+   * checkpoint changes nothing. */
+  expect(is, "stats");
+  std::string line;
+  std::getline(is, line);
+  expect(is, "estimator");
+  n = read_value<size_t>(is);
+  is >> std::ws;
+  const std::string levels = std::to_string(n) + "\n" + read_lines(is, n);
+
+  expect(is, "completed");
+  n = read_value<size_t>(is);
+  std::set<Path> completed;
+  for (size_t i = 0; i < n; ++i)
+  {
+    expect(is, "subtree");
+    completed.insert(read_value<Path>(is));
+  }
+  /* Without the end marker, the last path may have been cut short. */
+  expect(is, "end");
+
+  incumbent = std::move(opt);
+  std::istringstream s(line);
+  stats.load(s);
+  std::istringstream l(levels);
+  est.load(l);
+  std::lock_guard<std::mutex> lock(_m);
+  _completed.insert(completed.begin(), completed.end());
+  _resumed = true;
+  return true;
+}
+
+}  // end namespace admission
@@ -0,0 +1,70 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/decomposition.hpp"
+
+#include "graph/components.hpp"
+#include "optimizers/optimizer.hpp"
+
+#include <memory>
+#include <omp.h>
+#include <stddef.h>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+namespace
+{
+
+/// Converts the operations of s to operations that find their vertices
+/// by their indices on application.
+OpSequence make_lazy(const OpSequence& s)
+{
+  OpSequence res = OpSequence::make_empty();
+  for (const auto& opc : s)
+  {
+    OpCont lazy = opc;
+    lazy._kind = is_elimination(opc) ? LAZY_ELI_OP : LAZY_ACC_OP;
+    res += OpSequence{lazy};
+  }
+  return res;
+}
+
+}  // end anonymous namespace
+
+OpSequence solve_components(Optimizer& op, FaceDAG& g)
+{
+  auto comps = split_components(g);
+  if (comps.size() < 2)
+  {
+    return op.solve(g);
+  }
+
+  std::vector<OpSequence> seqs(comps.size(), OpSequence::make_empty());
+  if (op.is_parallel())
+  {
+    for (size_t c = 0; c < comps.size(); ++c)
+    {
+      seqs[c] = make_lazy(op.solve(*comps[c]));
+    }
+  }
+  else
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t c = 0; c < comps.size(); ++c)
+    {
+      seqs[c] = make_lazy(op.solve(*comps[c]));
+    }
+  }
+
+  OpSequence res = OpSequence::make_empty();
+  for (auto& s : seqs)
+  {
+    res += std::move(s);
+  }
+  return res;
+}
+
+}  // end namespace admission
@@ -0,0 +1,189 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/estimator.hpp"
+
+#include "misc/thread_slot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stddef.h>
+#include <vector>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+void Estimator::init(const FaceDAG& g)
+{
+  clear();
+  /* Every operation removes an edge or accumulates a vertex, so this
+   * bounds the depth of the search tree. */
+  _depths = 2 * num_edges(g) + num_vertices(g) + 1;
+  _deepest = 0;
+  for (Shard& s : _shards)
+  {
+    s.pending = 0;
+  }
+  std::atomic_store(&_est, std::make_shared<const std::vector<double>>());
+  _probe = 0;
+}
+
+void Estimator::clear()
+{
+  for (Shard& s : _shards)
+  {
+    delete[] s.levels.exchange(nullptr);
+  }
+}
+
+Estimator::Level* Estimator::level(const size_t d)
+{
+  if (d >= _depths)
+  {
+    return nullptr;
+  }
+  Shard& s = _shards[thread_slot() % n_shards];
+  Level* l = s.levels.load(std::memory_order_acquire);
+  if (l == nullptr)
+  {
+    /* Threads sharing the slot may race to allocate the counters. */
+    Level* n = new Level[_depths];
+    if (s.levels.compare_exchange_strong(l, n, std::memory_order_acq_rel))
+    {
+      l = n;
+    }
+    else
+    {
+      delete[] n;
+    }
+  }
+  return l + d;
+}
+
+void Estimator::add_sample(const size_t d, const double& v)
+{
+  if (v < 1.0)
+  {
+    return;
+  }
+  Level* l = level(d);
+  if (l == nullptr)
+  {
+    return;
+  }
+  l->samples.fetch_add(1, std::memory_order_relaxed);
+  l->branches.fetch_add(static_cast<size_t>(v), std::memory_order_relaxed);
+
+  size_t deepest = _deepest.load(std::memory_order_relaxed);
+  while (d > deepest && !_deepest.compare_exchange_weak(
+                            deepest, d, std::memory_order_relaxed))
+  {}
+
+  Shard& s = _shards[thread_slot() % n_shards];
+  if (s.pending.fetch_add(1, std::memory_order_relaxed) + 1 >= merge_interval)
+  {
+    s.pending = 0;
+    merge();
+  }
+}
+
+void Estimator::merge()
+{
+  /* Another thread merging already is as good as merging here. */
+  if (_merging.test_and_set(std::memory_order_acquire))
+  {
+    return;
+  }
+  const size_t n = std::min(_deepest.load() + 1, _depths);
+  std::vector<size_t> samples(n, 0);
+  std::vector<size_t> branches(n, 0);
+  std::vector<size_t> cuts(n, 0);
+  for (const Shard& s : _shards)
+  {
+    const Level* l = s.levels.load(std::memory_order_acquire);
+    if (l == nullptr)
+    {
+      continue;
+    }
+    for (size_t d = 0; d < n; ++d)
+    {
+      samples[d] += l[d].samples.load(std::memory_order_relaxed);
+      branches[d] += l[d].branches.load(std::memory_order_relaxed);
+      cuts[d] += l[d].cuts.load(std::memory_order_relaxed);
+    }
+  }
+
+  /* The subtree at depth d holds the node and the subtrees of its
+   * branches that were not cut, on average. */
+  auto est = std::make_shared<std::vector<double>>(n + 1, 1.0);
+  for (size_t d = n; d-- > 0;)
+  {
+    double e = 1.0;
+    if (samples[d] > 0)
+    {
+      e = std::max(
+          0.0, (static_cast<double>(branches[d]) - cuts[d]) / samples[d]);
+    }
+    (*est)[d] = 1.0 + e * (*est)[d + 1];
+  }
+  std::atomic_store(
+      &_est, std::shared_ptr<const std::vector<double>>(std::move(est)));
+  _merging.clear(std::memory_order_release);
+}
+
+void Estimator::save(std::ostream& os) const
+{
+  const size_t n = std::min(_deepest.load() + 1, _depths);
+  std::vector<size_t> counts(3 * n, 0);
+  for (const Shard& s : _shards)
+  {
+    const Level* l = s.levels.load(std::memory_order_acquire);
+    for (size_t d = 0; l != nullptr && d < n; ++d)
+    {
+      counts[3 * d] += l[d].samples.load(std::memory_order_relaxed);
+      counts[3 * d + 1] += l[d].branches.load(std::memory_order_relaxed);
+      counts[3 * d + 2] += l[d].cuts.load(std::memory_order_relaxed);
+    }
+  }
+  os << n << "\n";
+  for (size_t d = 0; d < n; ++d)
+  {
+    os << counts[3 * d] << " " << counts[3 * d + 1] << " "
+       << counts[3 * d + 2] << "\n";
+  }
+}
+
+void Estimator::load(std::istream& is)
+{
+  size_t n = 0;
+  is >> n;
+  for (size_t d = 0; d < n; ++d)
+  {
+    size_t samples = 0, branches = 0, cuts = 0;
+    is >> samples >> branches >> cuts;
+    Level* l = level(d);
+    if (l == nullptr || samples == 0)
+    {
+      continue;
+    }
+    l->samples.fetch_add(samples, std::memory_order_relaxed);
+    l->branches.fetch_add(branches, std::memory_order_relaxed);
+    l->cuts.fetch_add(cuts, std::memory_order_relaxed);
+    size_t deepest = _deepest.load(std::memory_order_relaxed);
+    while (d > deepest && !_deepest.compare_exchange_weak(
+                              deepest, d, std::memory_order_relaxed))
+    {}
+  }
+  merge();
+}
+
+double Estimator::calc_est(const size_t d) const
+{
+  const auto est = std::atomic_load(&_est);
+  return (est && d < est->size()) ? (*est)[d] : 1.0;
+}
+
+}  // end namespace admission
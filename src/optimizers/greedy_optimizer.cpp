@@ -4,28 +4,261 @@
 
 #include "graph/DAG.hpp"
 #include "graph/tikz.hpp"
+#include "graph/trail.hpp"
+#include "misc/arena.hpp"
 #include "operations/find_eliminations.hpp"
 #include "operations/op_sequence.hpp"
 #include "elimination_algorithm.hpp"
 #include "global_modes.hpp"
 
+#include <boost/foreach.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <set>
 #include <stddef.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 // **************************** Source contents ***************************** //
 
 namespace admission
 {
 
+namespace
+{
+
+/**\brief Indexed priority queue of the candidate operations of the
+ * greedy heuristic.
+ *
+ * Holds every vertex that is mergeable by preaccumulation and the cost
+ * of the cheapest elimination of every edge. After an operation was
+ * applied, only the candidates around the vertices it touched are
+ * re-evaluated, instead of all vertices and edges.
+ *
+ * The choice is the same as the one of a full scan in vertex order:
+ * the mergeable vertex with the highest index, otherwise the cheapest
+ * elimination that comes first in the order of the out edges.
+ */
+class CandidateQueue
+{
+ public:
+  /**\brief Evaluates all candidates on g.
+   *
+   * The containers are taken from the arena of the calling thread, so
+   * the parallel evaluation only writes to memory allocated before.
+   */
+  explicit CandidateQueue(const FaceDAG& g)
+  {
+    const int V = num_vertices(g);
+    _by_source.resize(V);
+    _in_region.assign(V, false);
+    ArenaVector<char> mergeable(V, false);
+    ArenaVector<size_t> first(V + 1, 0);
+    for (int v = 0; v < V; ++v)
+    {
+      first[v + 1] = first[v] + out_degree(v, g);
+    }
+    ArenaVector<Elim> all(first[V]);
+    ArenaVector<size_t> n(V, 0);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int v = 0; v < V; ++v)
+    {
+      mergeable[v] = get_mergeable_preacc(v, g).cost() < OpSequence::max;
+      n[v] = evaluate(v, g, all.data() + first[v]);
+    }
+    for (int v = 0; v < V; ++v)
+    {
+      if (mergeable[v])
+      {
+        _mergeable.insert(v);
+      }
+      const Elim* e = all.data() + first[v];
+      _by_source[v].assign(e, e + n[v]);
+      _elims.insert(e, e + n[v]);
+    }
+  }
+
+  /**\brief Returns the next operation of the greedy heuristic on g,
+   * or OpSequence::make_max() if there is none.
+   */
+  OpSequence top(const FaceDAG& g) const
+  {
+    if (!_mergeable.empty())
+    {
+      return get_mergeable_preacc(*_mergeable.rbegin(), g);
+    }
+    if (!_elims.empty())
+    {
+      const Elim& e = *_elims.begin();
+      auto ijk = edge(e.ij, e.jk, g).first;
+      OpSequence s = get_cheapest_elim(ijk, g);
+      assert(s.cost() == e.cost && "Stale candidate in the greedy queue.");
+      return s;
+    }
+    return OpSequence::make_max();
+  }
+
+  /**\brief Re-evaluates the candidates around the vertices that were
+   * touched after mark m of the trail.
+   */
+  void update(const FaceDAG& g, const Trail& trail, const Trail::Mark m)
+  {
+    const size_t V = num_vertices(g);
+    if (_by_source.size() < V)
+    {
+      _by_source.resize(V);
+      _in_region.resize(V, false);
+    }
+
+    TouchedVertices touched;
+    trail.touched(m, [&](const VertexDesc v) { touched.push_back(v); });
+
+    // Eliminations of edges that touch a modified vertex.
+    for (const VertexDesc d : touched)
+    {
+      mark(d);
+      BOOST_FOREACH(auto ie, in_edges(d, g))
+      {
+        mark(source(ie, g));
+      }
+    }
+    for (const VertexDesc v : _region)
+    {
+      for (const Elim& e : _by_source[v])
+      {
+        _elims.erase(e);
+      }
+      _by_source[v].resize(out_degree(v, g));
+      _by_source[v].resize(evaluate(v, g, _by_source[v].data()));
+      _elims.insert(_by_source[v].begin(), _by_source[v].end());
+    }
+    clear_region();
+
+    // Merge candidates within the second neighbourhood, which
+    // has_merge_candidate(...) and get_mergeable_preacc(...) look at.
+    for (const VertexDesc d : touched)
+    {
+      mark(d);
+      BOOST_FOREACH(auto ie, in_edges(d, g))
+      {
+        const VertexDesc p = source(ie, g);
+        mark(p);
+        BOOST_FOREACH(auto oe, out_edges(p, g))
+        {
+          mark(target(oe, g));
+        }
+      }
+      BOOST_FOREACH(auto oe, out_edges(d, g))
+      {
+        const VertexDesc s = target(oe, g);
+        mark(s);
+        BOOST_FOREACH(auto ie, in_edges(s, g))
+        {
+          mark(source(ie, g));
+        }
+      }
+    }
+    for (const VertexDesc v : _region)
+    {
+      if (get_mergeable_preacc(v, g).cost() < OpSequence::max)
+      {
+        _mergeable.insert(v);
+      }
+      else
+      {
+        _mergeable.erase(v);
+      }
+    }
+    clear_region();
+  }
+
+ private:
+  /// Cheapest elimination of the edge (ij, jk).
+  struct Elim
+  {
+    flop_t cost;
+    VertexDesc ij;
+    /// Position of the edge among the out edges of ij.
+    size_t pos;
+    VertexDesc jk;
+
+    bool operator<(const Elim& o) const
+    {
+      return cost < o.cost ||
+             (cost == o.cost && (ij < o.ij || (ij == o.ij && pos < o.pos)));
+    }
+  };
+
+  /**\brief Evaluates the eliminations of all out edges of ij.
+   *
+   * @param[out] res Room for out_degree(ij, g) eliminations.
+   * @returns The number of eliminations written to res.
+   */
+  static size_t evaluate(const VertexDesc ij, const FaceDAG& g, Elim* res)
+  {
+    if (!in_degree(ij, g))
+    {
+      return 0;
+    }
+    size_t n = 0;
+    size_t pos = 0;
+    BOOST_FOREACH(auto ijk, out_edges(ij, g))
+    {
+      const VertexDesc jk = target(ijk, g);
+      if (out_degree(jk, g))
+      {
+        res[n++] = Elim{get_cheapest_elim(ijk, g).cost(), ij, pos, jk};
+      }
+      ++pos;
+    }
+    return n;
+  }
+
+  /// Adds v to the region to re-evaluate.
+  void mark(const VertexDesc v)
+  {
+    if (!_in_region[v])
+    {
+      _in_region[v] = true;
+      _region.push_back(v);
+    }
+  }
+
+  void clear_region()
+  {
+    for (const VertexDesc v : _region)
+    {
+      _in_region[v] = false;
+    }
+    _region.clear();
+  }
+
+  /// Vertices that are mergeable by preaccumulation.
+  std::set<VertexDesc, std::less<VertexDesc>, ArenaAllocator<VertexDesc>>
+      _mergeable;
+  /// All eliminations, cheapest first.
+  std::set<Elim, std::less<Elim>, ArenaAllocator<Elim>> _elims;
+  /// The entries of _elims by the source of their edge.
+  ArenaVector<ArenaVector<Elim>> _by_source;
+  /// The vertices to re-evaluate.
+  ArenaVector<VertexDesc> _region;
+  ArenaVector<char> _in_region;
+};
+
+}  // end anonymous namespace
+
 OpSequence GreedyOptimizer::solve(FaceDAG& g) const
 {
   return greedy_solve(g);
 }
 
-OpSequence GreedyOptimizer::greedy_solve(FaceDAG& g, bool diagnostics) const
+OpSequence GreedyOptimizer::greedy_solve(
+    FaceDAG& g, bool diagnostics, Trail* trail) const
 {
   auto elims = OpSequence::make_empty();
   auto new_elim = OpSequence::make_max();
@@ -38,10 +271,23 @@ OpSequence GreedyOptimizer::greedy_solve(FaceDAG& g, bool diagnostics) const
     admission::write_tikz("0.tex", g);
   }
 
-  while ((new_elim = get_greedy_elim_on_any_graph(g)).cost() < OpSequence::max)
+  /* Without a trail of the caller, the modifications are recorded on
+   * a local one, which only ever holds those of the last operation. */
+  Trail own;
+  Trail& t = trail ? *trail : own;
+  ArenaScope scope;
+  CandidateQueue queue(g);
+
+  while ((new_elim = queue.top(g)).cost() < OpSequence::max)
   {
     n++;
-    new_elim.apply(g);
+    const Trail::Mark m = t.mark();
+    new_elim.apply(g, &t);
+    queue.update(g, t, m);
+    if (trail == nullptr)
+    {
+      own.forget(m);
+    }
     elims += std::move(new_elim);
     if (_diagnostics && diagnostics)
     {
@@ -53,7 +299,7 @@ OpSequence GreedyOptimizer::greedy_solve(FaceDAG& g, bool diagnostics) const
   }
 
   elims += global_preaccumulation_ops(g);
-  preaccumulate_all(g);
+  preaccumulate_all(g, false, trail);
 
   if (_diagnostics && diagnostics)
   {
@@ -66,25 +312,4 @@ OpSequence GreedyOptimizer::greedy_solve(FaceDAG& g, bool diagnostics) const
   return elims;
 }
 
-/**
- * Returns either
- * a preaccumulation that merges two vertices
- * or
- * the cheaptest elimination.
- */
-OpSequence GreedyOptimizer::get_greedy_elim_on_any_graph(
-    const admission::FaceDAG& g) const
-{
-  // Check if there are vertices that are mergeable by preaccumulation
-  // cheaper than propagating their neighboring Jacobians through them.
-  auto [opt, ij] = get_mergeable_vertex_on_any_graph(g);
-
-  // If no suited mergeable vertex was found, find the cheapest elim.
-  if (opt.cost() == OpSequence::max)
-  {
-    opt = get_cheapest_elim_on_any_graph(g);
-  }
-  return opt;
-}
-
 }  // end namespace admission
@@ -0,0 +1,69 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/heuristic_policy.hpp"
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdexcept>
+#include <string>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+HeuristicMode to_heuristic_mode(const std::string& s)
+{
+  if (s == "always")
+  {
+    return HeuristicMode::Always;
+  }
+  if (s == "depth")
+  {
+    return HeuristicMode::Depth;
+  }
+  if (s == "estimate")
+  {
+    return HeuristicMode::Estimate;
+  }
+  if (s == "adaptive")
+  {
+    return HeuristicMode::Adaptive;
+  }
+  throw std::runtime_error(
+      "Unknown heuristic policy \"" + s +
+      "\"! Known policies are: always, depth, estimate, adaptive.");
+}
+
+bool HeuristicPolicy::run(const size_t depth, const Estimator& est) const
+{
+  if (depth == 0)
+  {
+    return true;
+  }
+  switch (_mode)
+  {
+    case HeuristicMode::Always:
+    {
+      return true;
+    }
+    case HeuristicMode::Depth:
+    {
+      return depth <= _depth;
+    }
+    case HeuristicMode::Estimate:
+    {
+      return est.calc_est(depth) >= _min_subtree;
+    }
+    case HeuristicMode::Adaptive:
+    {
+      const size_t halvings = std::min<size_t>(
+          _misses.load(std::memory_order_relaxed) / _window, 20);
+      const size_t period = size_t(1) << halvings;
+      return _nodes.fetch_add(1, std::memory_order_relaxed) % period == 0;
+    }
+  }
+  return true;
+}
+
+}  // end namespace admission
@@ -21,7 +21,8 @@
 namespace admission
 {
 
-OpSequence MinFillInOptimizer::min_fill_in_solve(FaceDAG& g, bool _write) const
+OpSequence MinFillInOptimizer::min_fill_in_solve(
+    FaceDAG& g, bool _write, Trail* trail) const
 {
   auto elims = OpSequence::make_empty();
   auto new_elim = OpSequence::make_max();
@@ -40,7 +41,7 @@ OpSequence MinFillInOptimizer::min_fill_in_solve(FaceDAG& g, bool _write) const
          OpSequence::max)
   {
     n++;
-    new_elim.apply(g);
+    new_elim.apply(g, trail);
     elims += std::move(new_elim);
     if (_diagnostics)
     {
@@ -51,7 +52,7 @@ OpSequence MinFillInOptimizer::min_fill_in_solve(FaceDAG& g, bool _write) const
     }
   }
   elims += global_preaccumulation_ops(g);
-  preaccumulate_all(g);
+  preaccumulate_all(g, false, trail);
   if (_diagnostics && _write)
   {
     VertexDesc leaf = add_vertex(_meta_dag);
@@ -2,10 +2,9 @@
 
 #include "optimizers/optimizer.hpp"
 
+#include "graph/solved_state.hpp"
 #include "graph/tikz.hpp"
-#include "graph/utils.hpp"
 
-#include <boost/foreach.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
 #include <stddef.h>
@@ -17,22 +16,7 @@ namespace admission
 
 bool Optimizer::check_if_solved(const FaceDAG& g) const
 {
-  if (2 != longest_path(g))
-  {
-    return false;
-  }
-  else
-  {
-    auto Fprime_exists = boost::get(boost::vertex_acc_stat, g);
-    BOOST_FOREACH(auto ij, vertices(g))
-    {
-      if (in_degree(ij, g) && out_degree(ij, g) && !(Fprime_exists[ij]))
-      {
-        return false;
-      }
-    }
-  }
-  return true;
+  return SolvedState(g).solved();
 }
 
 /**Prints the meta DAG that is build when _diagnostics is turned on
@@ -0,0 +1,127 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/transposition_table.hpp"
+
+#include "graph/hash.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stddef.h>
+#include <stdexcept>
+#include <string>
+
+// **************************** Source contents ***************************** //
+
+namespace admission
+{
+
+TTReplacement to_tt_replacement(const std::string& s)
+{
+  if (s == "depth")
+  {
+    return TTReplacement::Depth;
+  }
+  if (s == "always")
+  {
+    return TTReplacement::Always;
+  }
+  throw std::runtime_error(
+      "Unknown transposition table policy \"" + s +
+      "\"! Known policies are: depth, always.");
+}
+
+void TranspositionTable::resize(
+    const size_t megabytes, const TTReplacement policy)
+{
+  _policy = policy;
+  std::vector<Bucket>().swap(_buckets);
+  _buckets.resize((megabytes << 20) / sizeof(Bucket));
+}
+
+void TranspositionTable::clear()
+{
+  std::fill(_buckets.begin(), _buckets.end(), Bucket());
+}
+
+bool TranspositionTable::probe(const FaceDAGHash& key, Entry& e) const
+{
+  if (!enabled())
+  {
+    return false;
+  }
+  const size_t b = bucket_of(key);
+  std::lock_guard<std::mutex> lock(_locks[b % n_locks]);
+  for (const auto& candidate : _buckets[b].entries)
+  {
+    if (candidate.used && candidate.key == key)
+    {
+      e = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TranspositionTable::store(
+    const FaceDAGHash& key, const flop_t lower, const flop_t upper,
+    const plength_t depth)
+{
+  if (!enabled())
+  {
+    return;
+  }
+  const size_t b = bucket_of(key);
+  std::lock_guard<std::mutex> lock(_locks[b % n_locks]);
+  Bucket& bucket = _buckets[b];
+
+  /* Tighten the bounds of an existing entry, or find a free slot. */
+  Entry* slot = nullptr;
+  for (auto& candidate : bucket.entries)
+  {
+    if (candidate.used && candidate.key == key)
+    {
+      candidate.lower = std::max(candidate.lower, lower);
+      candidate.upper = std::min(candidate.upper, upper);
+      candidate.depth = std::min(candidate.depth, depth);
+      return;
+    }
+    if (!candidate.used && slot == nullptr)
+    {
+      slot = &candidate;
+    }
+  }
+
+  /* The bucket is full: pick the victim according to the policy. */
+  if (slot == nullptr)
+  {
+    if (_policy == TTReplacement::Always)
+    {
+      slot = &bucket.entries[bucket.next];
+      bucket.next = (bucket.next + 1) % n_ways;
+    }
+    else
+    {
+      slot = &bucket.entries[0];
+      for (auto& candidate : bucket.entries)
+      {
+        if (candidate.depth > slot->depth)
+        {
+          slot = &candidate;
+        }
+      }
+      /* Entries closer to the root represent larger subtrees. */
+      if (slot->depth < depth)
+      {
+        return;
+      }
+    }
+  }
+
+  slot->key = key;
+  slot->lower = lower;
+  slot->upper = upper;
+  slot->depth = depth;
+  slot->used = true;
+}
+
+}  // end namespace admission
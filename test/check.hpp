@@ -0,0 +1,50 @@
+#ifndef TEST_CHECK_HPP
+#define TEST_CHECK_HPP
+
+// ******************************** Includes ******************************** //
+
+#include <iostream>
+
+// **************************** Header contents ***************************** //
+
+/// Number of failed checks of the test.
+inline int& failed_checks()
+{
+  static int n = 0;
+  return n;
+}
+
+/// Reports a failed check with its location and continues the test.
+#define ADM_CHECK(cond)                                                   \
+  do                                                                      \
+  {                                                                       \
+    if (!(cond))                                                          \
+    {                                                                     \
+      std::cout << __FILE__ << ":" << __LINE__ << ": check failed: "      \
+                << #cond << std::endl;                                    \
+      ++failed_checks();                                                  \
+    }                                                                     \
+  } while (false)
+
+/// Checks that stmt throws an exception of type E.
+#define ADM_CHECK_THROWS(stmt, E)                                         \
+  do                                                                      \
+  {                                                                       \
+    bool thrown = false;                                                  \
+    try                                                                   \
+    {                                                                     \
+      stmt;                                                               \
+    }                                                                     \
+    catch (const E&)                                                      \
+    {                                                                     \
+      thrown = true;                                                      \
+    }                                                                     \
+    if (!thrown)                                                          \
+    {                                                                     \
+      std::cout << __FILE__ << ":" << __LINE__ << ": " << #stmt           \
+                << " did not throw " << #E << std::endl;                  \
+      ++failed_checks();                                                  \
+    }                                                                     \
+  } while (false)
+
+#endif  // TEST_CHECK_HPP
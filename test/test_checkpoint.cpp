@@ -0,0 +1,108 @@
+// ******************************** Includes ******************************** //
+
+#include "optimizers/checkpoint.hpp"
+
+#include "graph/hash.hpp"
+#include "operations/op_sequence.hpp"
+#include "optimizers/estimator.hpp"
+#include "optimizers/optimizer_stats.hpp"
+
+#include "check.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// **************************** Source contents ***************************** //
+
+namespace
+{
+
+admission::OpSequence read(const std::string& s)
+{
+  admission::OpSequence res = admission::OpSequence::make_empty();
+  admission::read_sequence(std::istringstream(s), res);
+  return res;
+}
+
+/// Reads the checkpoint in s into a fresh Checkpoint c.
+bool resume(
+    admission::Checkpoint& c, const std::string& s,
+    const admission::FaceDAGHash& root, admission::OpSequence& incumbent)
+{
+  admission::OptimizerStats stats;
+  admission::Estimator est;
+  c.reset(3);
+  std::istringstream is(s);
+  return c.read(is, root, incumbent, stats, est);
+}
+
+}  // end anonymous namespace
+
+int main()
+{
+  const admission::FaceDAGHash root{1, 2};
+  const admission::OpSequence old_opt = read("PRE ADJ 1 2 5\n");
+  const admission::OpSequence new_opt = read("PRE TAN 1 2 3\n");
+  admission::OptimizerStats stats;
+  admission::Estimator est;
+
+  /* A subtree that updates the incumbent and completes while the
+   * checkpoint is written must not be written with the old incumbent. */
+  admission::Checkpoint c;
+  c.reset(3);
+  c.complete("0");
+  c.complete("1.2");
+  std::ostringstream os;
+  admission::OpSequence opt = old_opt;
+  c.write(
+      os, root,
+      [&]()
+      {
+        const admission::OpSequence res = opt;
+        opt = new_opt;
+        c.complete("2");
+        return res;
+      },
+      stats, est);
+
+  const std::string written = os.str();
+  admission::Checkpoint r;
+  admission::OpSequence incumbent = admission::OpSequence::make_empty();
+  ADM_CHECK(resume(r, written, root, incumbent));
+  ADM_CHECK(r.resumed());
+  ADM_CHECK(r.size() == 2);
+  ADM_CHECK(r.completed("0") && r.completed("1.2"));
+  ADM_CHECK(!r.completed("2") || incumbent.cost() == new_opt.cost());
+
+  /* Completed subtrees replace the subtrees below them only. */
+  c.complete("1");
+  ADM_CHECK(!c.completed("1.2") && c.completed("1"));
+  c.complete("11");
+  ADM_CHECK(c.completed("1") && c.completed("11"));
+
+  /* A checkpoint of a different face DAG is ignored. */
+  admission::Checkpoint o;
+  ADM_CHECK(!resume(o, written, admission::FaceDAGHash{3, 4}, incumbent));
+  ADM_CHECK(!o.resumed() && o.size() == 0);
+
+  /* Every truncated checkpoint is rejected without changing anything. */
+  for (size_t n = 0; n + 1 < written.size(); ++n)
+  {
+    admission::Checkpoint t;
+    admission::OpSequence inc = admission::OpSequence::make_empty();
+    ADM_CHECK_THROWS(
+        resume(t, written.substr(0, n), root, inc), std::runtime_error);
+    ADM_CHECK(!t.resumed() && t.size() == 0 && inc.size() == 0);
+  }
+
+  /* Garbled checkpoints, too. */
+  std::string garbled = written;
+  garbled.replace(garbled.find("PRE ADJ"), 7, "PRE XYZ");
+  ADM_CHECK_THROWS(resume(r, garbled, root, incumbent), std::runtime_error);
+  garbled = written;
+  garbled.replace(garbled.find("completed 2"), 11, "completed x");
+  ADM_CHECK_THROWS(resume(r, garbled, root, incumbent), std::runtime_error);
+
+  return failed_checks() ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// ******************************** Includes ******************************** //
+
+#include "misc/periodic_thread.hpp"
+
+#include "check.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// **************************** Source contents ***************************** //
+
+/// A long call must neither block stop(...) nor be called concurrently.
+int main()
+{
+  using clock = std::chrono::steady_clock;
+  admission::PeriodicThread t;
+  std::atomic<int> calls{0};
+  std::atomic<int> running{0};
+  std::atomic<bool> overlapped{false};
+
+  t.start(
+      0.001,
+      [&]()
+      {
+        if (running++ > 0)
+        {
+          overlapped = true;
+        }
+        ++calls;
+        /* Runs until the thread is stopped, as a slow probe would. */
+        while (!t.stopping())
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        --running;
+      });
+
+  while (calls == 0)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto begin = clock::now();
+  t.stop(false);
+  const auto waited = clock::now() - begin;
+
+  ADM_CHECK(waited < std::chrono::seconds(1));
+  ADM_CHECK(calls == 1);
+  ADM_CHECK(!overlapped);
+
+  /* The last call on stop() runs, too. */
+  int last = 0;
+  t.start(3600, [&]() { ++last; });
+  t.stop();
+  ADM_CHECK(last == 1);
+  ADM_CHECK(t.stopping());
+
+  return failed_checks() ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// ******************************** Includes ******************************** //
+
+#include "operations/op_sequence.hpp"
+
+#include "check.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// **************************** Source contents ***************************** //
+
+namespace
+{
+
+/// A valid sequence as written by OpSequence::write(...).
+const std::string valid =
+    "PRE ADJ 1 2 1\n"
+    "ELI TAN 1 2 5 1\n"
+    "ELI ADJ 0 1 2 2\n";
+
+admission::OpSequence read(const std::string& s)
+{
+  admission::OpSequence res = admission::OpSequence::make_empty();
+  admission::read_sequence(std::istringstream(s), res);
+  return res;
+}
+
+}  // end anonymous namespace
+
+/// Malformed sequences must raise std::runtime_error, not abort or hang.
+int main()
+{
+  const admission::OpSequence s = read(valid);
+  ADM_CHECK(s.size() == 3);
+  ADM_CHECK(s.cost() == 4);
+  ADM_CHECK(read("").size() == 0);
+
+  /* A sequence without the final line break is complete. */
+  ADM_CHECK(read(valid.substr(0, valid.size() - 1)).size() == 3);
+
+  /* Every cut inside an operation leaves it incomplete. */
+  for (const size_t n : {4, 8, 10, 12, 20, 26})
+  {
+    ADM_CHECK_THROWS(read(valid.substr(0, n)), std::runtime_error);
+  }
+
+  /* Garbled selectors, directions and numbers. */
+  ADM_CHECK_THROWS(read("PRE XYZ 1 2 3\n"), std::runtime_error);
+  ADM_CHECK_THROWS(read("ELI FOO 1 2 5 1\n"), std::runtime_error);
+  ADM_CHECK_THROWS(read("PRE ADJ a b 3\n"), std::runtime_error);
+  ADM_CHECK_THROWS(read("ELI MUL 1 2 x 1\n" + valid), std::runtime_error);
+  ADM_CHECK_THROWS(read(valid + "ACC ADJ 1 2 3\n"), std::runtime_error);
+  ADM_CHECK_THROWS(
+      admission::dir_to_s(static_cast<admission::dir_t>(42)),
+      std::runtime_error);
+
+  return failed_checks() ? 1 : 0;
+}